@@ -4,3 +4,18 @@
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ForgeFX, "ForgeFX" );
+
+DEFINE_STAT(STAT_ForgeFX_BuildAssembly);
+DEFINE_STAT(STAT_ForgeFX_DetachPart);
+DEFINE_STAT(STAT_ForgeFX_ReattachPart);
+DEFINE_STAT(STAT_ForgeFX_FindNearestAttachTarget);
+DEFINE_STAT(STAT_ForgeFX_HighlightTick);
+DEFINE_STAT(STAT_ForgeFX_CinematicTick);
+DEFINE_STAT(STAT_ForgeFX_ShowcaseTick);
+DEFINE_STAT(STAT_ForgeFX_InteractionTrace);
+DEFINE_STAT(STAT_ForgeFX_LiveMIDs);
+DEFINE_STAT(STAT_ForgeFX_DetachedActors);
+DEFINE_STAT(STAT_ForgeFX_RenderStateDirties);
+
+CSV_DEFINE_CATEGORY_MODULE(FORGEFX_API, ForgeFX, true);
+UE_TRACE_CHANNEL_DEFINE(ForgeFXChannel);
@@ -3,4 +3,31 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
+// "stat ForgeFX" in game; the same scopes show up in Insights (ForgeFX channel) and in CSV captures (ForgeFX category)
+DECLARE_STATS_GROUP(TEXT("ForgeFX"), STATGROUP_ForgeFX, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BuildAssembly"), STAT_ForgeFX_BuildAssembly, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DetachPart"), STAT_ForgeFX_DetachPart, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ReattachPart"), STAT_ForgeFX_ReattachPart, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindNearestAttachTarget"), STAT_ForgeFX_FindNearestAttachTarget, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Highlight Tick"), STAT_ForgeFX_HighlightTick, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cinematic Tick"), STAT_ForgeFX_CinematicTick, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Showcase Tick"), STAT_ForgeFX_ShowcaseTick, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Interaction Trace"), STAT_ForgeFX_InteractionTrace, STATGROUP_ForgeFX, FORGEFX_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Part MIDs"), STAT_ForgeFX_LiveMIDs, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Detached Part Actors"), STAT_ForgeFX_DetachedActors, STATGROUP_ForgeFX, FORGEFX_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Render State Dirties"), STAT_ForgeFX_RenderStateDirties, STATGROUP_ForgeFX, FORGEFX_API); // per frame
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FORGEFX_API, ForgeFX);
+UE_TRACE_CHANNEL_EXTERN(ForgeFXChannel, FORGEFX_API);
+
+// Cycle stat + Insights CPU event + CSV timing for one ForgeFX hot path, e.g. FORGEFX_SCOPE(DetachPart)
+#define FORGEFX_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_ForgeFX_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(ForgeFX_##Name, ForgeFXChannel); \
+	CSV_SCOPED_TIMING_STAT(ForgeFX, Name)
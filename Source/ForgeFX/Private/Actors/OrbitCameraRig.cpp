@@ -1,6 +1,5 @@
 #include "Actors/OrbitCameraRig.h"
 #include "Camera/CameraComponent.h"
-#include "Components/SplineComponent.h"
 
 AOrbitCameraRig::AOrbitCameraRig()
 {
@@ -9,8 +8,6 @@ AOrbitCameraRig::AOrbitCameraRig()
 	SetRootComponent(Root);
 	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
 	Camera->SetupAttachment(Root);
-	Spline = CreateDefaultSubobject<USplineComponent>(TEXT("PathSpline"));
-	Spline->SetupAttachment(Root);
 }
 
 void AOrbitCameraRig::BeginPlay()
@@ -26,15 +23,67 @@ void AOrbitCameraRig::Setup(AActor* InTarget, float InRadius, float InHeight, fl
 
 void AOrbitCameraRig::UseCircularSplinePath(int32 NumPoints)
 {
-	bUseSpline = true; Spline->ClearSplinePoints();
-	const FVector C = GetActorLocation();
-	for (int32 i=0;i<NumPoints;++i)
+	PathTable = FOrbitPathTable::Get(Radius, Height, NumPoints);
+}
+
+TSharedRef<const FOrbitPathTable> FOrbitPathTable::Get(float Radius, float Height, int32 NumPoints)
+{
+	check(IsInGameThread());
+	NumPoints = NumPoints <3 ?0 : NumPoints;
+	static TMap<TTuple<float, float, int32>, TSharedRef<const FOrbitPathTable>> Cache;
+	if (const TSharedRef<const FOrbitPathTable>* Found = Cache.Find(MakeTuple(Radius, Height, NumPoints))) return *Found;
+
+	TSharedRef<FOrbitPathTable> Table = MakeShared<FOrbitPathTable>();
+	Table->Radius = Radius; Table->Height = Height;
+	if (NumPoints >0)
+	{
+		// Closed Hermite curve through the control points with Catmull-Rom tangents (what spline auto tangents give)
+		TArray<FVector, TInlineAllocator<64>> P; P.SetNum(NumPoints);
+		for (int32 i=0; i<NumPoints; ++i) { const float A = (float)i / (float)NumPoints *2.f * PI; P[i] = FVector(FMath::Cos(A)*Radius, FMath::Sin(A)*Radius, Height); }
+		constexpr int32 SubSteps =32;
+		TArray<FVector> Dense; TArray<float> Dist; Dense.Reserve(NumPoints * SubSteps +1); Dist.Reserve(NumPoints * SubSteps +1);
+		float MaxRadialError =0.f;
+		for (int32 i=0; i<NumPoints; ++i)
+		{
+			const FVector& P0 = P[i]; const FVector& P1 = P[(i +1) % NumPoints];
+			const FVector T0 = (P1 - P[(i + NumPoints -1) % NumPoints]) *0.5f, T1 = (P[(i +2) % NumPoints] - P0) *0.5f;
+			for (int32 k=0; k<SubSteps; ++k)
+			{
+				const FVector X = FMath::CubicInterp(P0, T0, P1, T1, (float)k / SubSteps);
+				Dist.Add(Dense.Num() ? Dist.Last() + FVector::Dist(Dense.Last(), X) :0.f); Dense.Add(X);
+				MaxRadialError = FMath::Max(MaxRadialError, FMath::Abs(FVector2D(X).Size() - Radius));
+			}
+		}
+		Dist.Add(Dist.Last() + FVector::Dist(Dense.Last(), Dense[0])); Dense.Add(Dense[0]);
+		// Sub-centimetre off the circle: the analytic form is cheaper and exact enough
+		Table->bAnalyticCircle = MaxRadialError <0.5f;
+		if (!Table->bAnalyticCircle)
+		{
+			Table->Samples.SetNumUninitialized(NumSamples);
+			int32 Seg =0;
+			for (int32 s=0; s<NumSamples; ++s)
+			{
+				const float D = Dist.Last() * s / NumSamples;
+				while (Seg +1 < Dist.Num() -1 && Dist[Seg +1] < D) ++Seg;
+				const float Len = Dist[Seg +1] - Dist[Seg];
+				Table->Samples[s] = FMath::Lerp(Dense[Seg], Dense[Seg +1], Len > KINDA_SMALL_NUMBER ? (D - Dist[Seg]) / Len :0.f);
+			}
+		}
+	}
+	Cache.Add(MakeTuple(Radius, Height, NumPoints), Table);
+	return Table;
+}
+
+FVector FOrbitPathTable::Evaluate(float T) const
+{
+	T -= FMath::FloorToFloat(T);
+	if (bAnalyticCircle)
 	{
-		const float A = (float)i / (float)NumPoints *2.f * PI;
-		const FVector P = C + FVector(FMath::Cos(A)*Radius, FMath::Sin(A)*Radius, Height);
-		Spline->AddSplinePoint(P, ESplineCoordinateSpace::World, false);
+		float S, C; FMath::SinCos(&S, &C, T *2.f * PI);
+		return FVector(C * Radius, S * Radius, Height);
 	}
-	Spline->UpdateSpline();
+	const float X = T * NumSamples; const int32 i = FMath::Min(FMath::FloorToInt32(X), NumSamples -1);
+	return FMath::Lerp(Samples[i], Samples[(i +1) % NumSamples], X - i);
 }
 
 void AOrbitCameraRig::StepManual(float DeltaDegrees)
@@ -47,16 +96,14 @@ void AOrbitCameraRig::Tick(float DeltaSeconds)
 	Super::Tick(DeltaSeconds);
 	AActor* T = Target.Get(); if (!T) return;
 	const FVector Center = T->GetActorLocation();
-	if (bUseSpline && Spline->GetNumberOfSplinePoints() >0)
+	if (PathTable.IsValid())
 	{
 		if (bAutoOrbit)
 		{
 			const float Speed = SpeedDegPerSec/360.f; // cycles per second
 			PathT = FMath::Fmod(PathT + Speed * DeltaSeconds,1.f);
 		}
-		const float Ln = Spline->GetSplineLength();
-		const FVector Pos = Spline->GetLocationAtDistanceAlongSpline(PathT * Ln, ESplineCoordinateSpace::World);
-		SetActorLocation(Pos);
+		SetActorLocation(Center + PathTable->Evaluate(PathT));
 		SetActorRotation((Center - GetActorLocation()).Rotation());
 	}
 	else
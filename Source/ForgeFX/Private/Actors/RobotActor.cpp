@@ -16,7 +16,7 @@
 #include "EnhancedInputSubsystems.h"
 #include "GameFramework/PlayerController.h"
 #include "DrawDebugHelpers.h"
-#include "EngineUtils.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
 
 static const FName Part_Torso(TEXT("Torso"));
 
@@ -55,9 +55,17 @@ bool ARobotActor::ForceCrosshairDetach(bool /*bDrag*/)
 	APlayerController* PC = GetWorld()->GetFirstPlayerController(); if (!PC) return false;
 	int32 SX=0,SY=0; PC->GetViewportSize(SX,SY); const float MX = SX*0.5f; const float MY = SY*0.5f;
 	FVector Origin, Dir; if (!PC->DeprojectScreenPositionToWorld(MX, MY, Origin, Dir)) return false;
+	FName Part;
 	FHitResult Hit; GetWorld()->LineTraceSingleByChannel(Hit, Origin, Origin + Dir *2000.f, ECC_Visibility);
-	if (Hit.GetActor() != this) return false; UPrimitiveComponent* Comp = Hit.GetComponent(); if (!Comp) return false;
-	FName Part; if (!Assembly->FindPartNameByComponent(Comp, Part) || Assembly->IsPartDetached(Part)) return false;
+	int32 Handle; FVector PickLocation; float PickDistance;
+	// Parts without collision: a picked part counts only if nothing blocks the view in front of it
+	if (Assembly->PickPart(Origin, Origin + Dir *2000.f, Handle, PickLocation, PickDistance) && (!Hit.bBlockingHit || PickDistance < Hit.Distance)) Part = Assembly->GetPartNameByHandle(Handle);
+	else
+	{
+		if (Hit.GetActor() != this) return false; UPrimitiveComponent* Comp = Hit.GetComponent(); if (!Comp) return false;
+		if (!Assembly->FindPartNameByHit(Comp, Hit.Item, Part)) return false;
+	}
+	if (Assembly->IsPartDetached(Part)) return false;
 	ARobotPartActor* NewActor=nullptr; if (!Assembly->DetachPart(Part, NewActor) || !NewActor) return false;
 	UpdateStatusText(false); return true;
 }
@@ -67,6 +75,7 @@ void ARobotActor::BeginPlay()
 	Super::BeginPlay();
 	if (Assembly)
 	{
+		Assembly->OnAssemblyReady.AddDynamic(this, &ARobotActor::OnAssemblyBuilt); // bound first: synchronous builds broadcast inline
 		Assembly->BuildAssembly();
 		Assembly->OnRobotPartDetach.AddDynamic(this, &ARobotActor::OnAssemblyPartDetached);
 		Assembly->OnRobotPartReattach.AddDynamic(this, &ARobotActor::OnAssemblyPartReattached);
@@ -192,13 +201,6 @@ void ARobotActor::SetStatusMessage(const FString& Msg)
 	if (!StatusWidget) return; if (UTextBlock* TB = Cast<UTextBlock>(StatusWidget->GetWidgetFromName(TEXT("StatusText")))) TB->SetText(FText::FromString(Msg));
 }
 
-void ARobotActor::SetCustomDepthAll(bool bEnable)
-{
-	if (!Assembly) return;
-	TArray<USceneComponent*> Targets; Assembly->GetAllAttachTargets(Targets);
-	for (USceneComponent* S : Targets) if (UStaticMeshComponent* C = Cast<UStaticMeshComponent>(S)) C->SetRenderCustomDepth(bEnable);
-}
-
 void ARobotActor::UpdateStatusText(bool bAttached)
 {
 	if (!StatusWidget) return;
@@ -209,28 +211,44 @@ void ARobotActor::UpdateStatusText(bool bAttached)
 void ARobotActor::OnHoverComponentChanged(UPrimitiveComponent* HitComponent, AActor* HitActor)
 {
 	if (!Assembly) return;
-	Assembly->ClearHoverOverride();
-	static TWeakObjectPtr<UPrimitiveComponent> LastHoverOutlineComp; if (LastHoverOutlineComp.IsValid()) LastHoverOutlineComp->SetRenderCustomDepth(false); LastHoverOutlineComp.Reset();
-	FName PartName = NAME_None;
-	if (HitComponent && Assembly->FindPartNameByComponent(HitComponent, PartName))
+	FName PartName = NAME_None; UStaticMeshComponent* OutlineComp = nullptr; bool bWholeRobot = false;
+	const int32 HitItem = CachedTrace.IsValid() ? CachedTrace->GetHoveredItem() : INDEX_NONE;
+	if (HitComponent && Assembly->FindPartNameByHit(HitComponent, HitItem, PartName))
+	{
+		if (PartName == Part_Torso) bWholeRobot = true;
+		else if (!Assembly->IsPartInstanced(PartName)) OutlineComp = Assembly->GetPartByName(PartName); // instanced: per-instance highlight only; outlining the shared ISMC would light every instance
+	}
+	else if (ARobotPartActor* PartActor = Cast<ARobotPartActor>(HitActor))
+	{
+		PartName = PartActor->GetPartName(); OutlineComp = PartActor->GetMeshComponent();
+	}
+	SetHoverState(PartName, OutlineComp, bWholeRobot);
+}
+
+void ARobotActor::SetHoverState(FName PartName, UStaticMeshComponent* OutlineComp, bool bOutlineWholeRobot)
+{
+	if (PartName != HoveredPartName)
 	{
-		HoveredPartName = PartName; TArray<FName> One{ PartName }; Assembly->ApplyHighlightScalarToParts(One,1.f);
-		if (PartName == Part_Torso) SetCustomDepthAll(true);
+		// Hover off clears every part (also parts lit by a whole-robot highlight); moving between parts only swaps the two
+		if (PartName.IsNone()) Assembly->ApplyHighlightScalarAll(0.f);
 		else
 		{
-			SetCustomDepthAll(false);
-			if (UStaticMeshComponent* Comp = Assembly->GetPartByName(PartName)) { Comp->SetRenderCustomDepth(true); LastHoverOutlineComp = Comp; Assembly->ApplyHoverOverride(Comp); }
+			Assembly->SetPartHighlightTarget(Assembly->FindPartHandle(HoveredPartName),0.f);
+			Assembly->SetPartHighlightTarget(Assembly->FindPartHandle(PartName),1.f);
 		}
+		HoveredPartName = PartName;
 	}
-	else if (ARobotPartActor* PartActor = Cast<ARobotPartActor>(HitActor))
+	// Old outline off first so the whole-robot toggle and the new outline below win
+	UStaticMeshComponent* OldOutline = HoverOutlineComp.Get();
+	if (OldOutline != OutlineComp)
 	{
-		HoveredPartName = PartActor->GetPartName(); TArray<FName> One{ HoveredPartName }; Assembly->ApplyHighlightScalarToParts(One,1.f);
-		SetCustomDepthAll(false);
-		if (UStaticMeshComponent* Comp = PartActor->GetMeshComponent()) { Comp->SetRenderCustomDepth(true); LastHoverOutlineComp = Comp; Assembly->ApplyHoverOverride(Comp); }
+		if (OldOutline) OldOutline->SetRenderCustomDepth(false);
+		Assembly->ClearHoverOverride(); HoverOutlineComp.Reset();
 	}
-	else
+	if (bOutlineWholeRobot != bHoverOutlinesRobot) { Assembly->SetRenderCustomDepthAll(bOutlineWholeRobot); bHoverOutlinesRobot = bOutlineWholeRobot; }
+	if (OutlineComp && OutlineComp != OldOutline)
 	{
-		HoveredPartName = NAME_None; Assembly->ApplyHighlightScalarAll(0.f); SetCustomDepthAll(false);
+		OutlineComp->SetRenderCustomDepth(true); HoverOutlineComp = OutlineComp; Assembly->ApplyHoverOverride(OutlineComp);
 	}
 }
 
@@ -247,9 +265,24 @@ void ARobotActor::UpdateReattachPreview()
 			if (Pair.Key.IsValid()) Pair.Key->SetMaterial(0, Pair.Value);
 		}
 		PreviewOriginalMaterials.Empty(); PreviewMIDs.Empty(); CurrentPreviewComp.Reset();
+		ClearSnapPreviewPart();
 		return;
 	}
 	FName DragName = PartInteraction->GetDraggedPartName();
+	const FRobotPartSpec* DragSpec = Assembly->FindPartSpec(DragName);
+	if (DragSpec && (Assembly->IsPartInstanced(DragSpec->ParentPartName) || Assembly->UsesPrimitiveCustomData()))
+	{
+		// Instanced parent / custom data mode: snap color goes through custom data (see UpdateSnapMaterialParams)
+		if (SnapPreviewPart != DragSpec->ParentPartName) { ClearSnapPreviewPart(); SnapPreviewPart = DragSpec->ParentPartName; }
+		// Pulse is global, so one collection write per frame instead of a MID per previewed part
+		const URobotAssemblyConfig* Config = Assembly->AssemblyConfig;
+		if (UMaterialParameterCollectionInstance* Collection = Config && Config->HighlightCollection ? GetWorld()->GetParameterCollectionInstance(Config->HighlightCollection) : nullptr)
+		{
+			PreviewAccumTime += GetWorld()->GetDeltaSeconds();
+			Collection->SetScalarParameterValue(Config->PulseParam,0.5f +0.5f * FMath::Sin(PreviewAccumTime * PreviewPulseSpeed * PI));
+		}
+		return;
+	}
 	USceneComponent* Parent; FName Socket;
 	if (Assembly->GetAttachParentAndSocket(DragName, Parent, Socket) && Parent)
 	{
@@ -289,7 +322,7 @@ void ARobotActor::UpdateSnapReadiness()
 	USceneComponent* Parent; FName Socket; if (!Assembly->GetAttachParentAndSocket(DragName, Parent, Socket) || !Parent) { UpdateSnapMaterialParams(); return; }
 	if (ARobotPartActor* Dragged = PartInteraction->GetDraggedPartActor())
 	{
-		const FTransform SocketWorld = Parent->GetSocketTransform(Socket, RTS_World);
+		FTransform SocketWorld; Assembly->GetAttachSocketWorldTransform(DragName, SocketWorld);
 		const float Dist = FVector::Dist(Dragged->GetActorLocation(), SocketWorld.GetLocation());
 		const float AngleDiff = Dragged->GetActorQuat().AngularDistance(SocketWorld.GetRotation()) *180.f/PI;
 		bSnapReady = (Dist <= AttachPosTolerance) && (AngleDiff <= AttachAngleToleranceDeg);
@@ -305,6 +338,10 @@ void ARobotActor::UpdateSnapReadiness()
 
 void ARobotActor::UpdateSnapMaterialParams()
 {
+	if (!SnapPreviewPart.IsNone() && Assembly && SnapPreviewPushedState != (bSnapReady ?1 :0))
+	{
+		Assembly->SetPartSnapColor(SnapPreviewPart, bSnapReady ? SnapReadyColor : SnapNotReadyColor); SnapPreviewPushedState = bSnapReady ?1 :0;
+	}
 	if (!CurrentPreviewComp.IsValid()) return;
 	if (UMaterialInstanceDynamic* MID = PreviewMIDs.FindRef(CurrentPreviewComp))
 	{
@@ -312,6 +349,13 @@ void ARobotActor::UpdateSnapMaterialParams()
 	}
 }
 
+void ARobotActor::ClearSnapPreviewPart()
+{
+	if (SnapPreviewPart.IsNone()) return;
+	if (Assembly) Assembly->SetPartSnapColor(SnapPreviewPart, FLinearColor::Black);
+	SnapPreviewPart = NAME_None; SnapPreviewPushedState = INDEX_NONE;
+}
+
 void ARobotActor::PositionSocketInfoWidget(const FVector2D& ScreenPos)
 {
 	if (!SocketInfoWidget) return;
@@ -328,7 +372,7 @@ void ARobotActor::BatchDetachSelected()
 
 void ARobotActor::BatchReattachSelected()
 {
-	if (!Assembly) return; int32 Count=0; for (FName P : SelectedParts){ if (Assembly->IsPartDetached(P)){ for (TActorIterator<ARobotPartActor> It(GetWorld()); It; ++It){ if (It->GetPartName()==P){ if (Assembly->ReattachPart(P, *It)) ++Count; break; } } } }
+	if (!Assembly) return; int32 Count=0; for (FName P : SelectedParts){ if (Assembly->IsPartDetached(P) && Assembly->ReattachDetachedPart(P)) ++Count; }
 	ShowPrompt(FString::Printf(TEXT("Reattached %d selected"), Count),1.5f);
 }
 
@@ -337,6 +381,7 @@ void ARobotActor::ClearSelection()
 	// restore materials
 	for (FName P : SelectedParts)
 	{
+		if (Assembly && Assembly->SetPartSelected(P, false)) continue;
 		if (UStaticMeshComponent* Comp = Assembly? Assembly->GetPartByName(P):nullptr)
 		{
 			Comp->SetRenderCustomDepth(false);
@@ -352,14 +397,18 @@ void ARobotActor::TogglePartSelection(FName PartName)
 	if (PartName.IsNone() || !Assembly) return;
 	if (SelectedParts.Contains(PartName))
 	{
-		SelectedParts.Remove(PartName); if (UStaticMeshComponent* Comp = Assembly->GetPartByName(PartName)) { Comp->SetRenderCustomDepth(false); }
+		SelectedParts.Remove(PartName);
+		if (!Assembly->SetPartSelected(PartName, false)) if (UStaticMeshComponent* Comp = Assembly->GetPartByName(PartName)) { Comp->SetRenderCustomDepth(false); }
 		ShowPrompt(TEXT("Deselected part"),0.8f); UpdateSnapMaterialParams(); return;
 	}
 	SelectedParts.Add(PartName);
-	if (UStaticMeshComponent* Comp = Assembly->GetPartByName(PartName))
+	if (!Assembly->SetPartSelected(PartName, true))
 	{
-		Comp->SetRenderCustomDepth(true);
-		if (SelectedPreviewMaterial) Comp->SetMaterial(0, SelectedPreviewMaterial);
+		if (UStaticMeshComponent* Comp = Assembly->GetPartByName(PartName))
+		{
+			Comp->SetRenderCustomDepth(true);
+			if (SelectedPreviewMaterial) Comp->SetMaterial(0, SelectedPreviewMaterial);
+		}
 	}
 	ShowPrompt(TEXT("Selected part"),0.8f); UpdateSnapMaterialParams();
 }
@@ -368,11 +417,8 @@ void ARobotActor::DumpAssemblyState(){ if (Assembly) Assembly->DumpState(); }
 
 void ARobotActor::EnforceHideForDetached()
 {
-	if (!Assembly || !Assembly->AssemblyConfig) return;
-	for (const FRobotPartSpec& Spec : Assembly->AssemblyConfig->Parts)
-		if (Assembly->IsPartDetached(Spec.PartName))
-			if (UStaticMeshComponent* Comp = Assembly->GetPartByName(Spec.PartName))
-				{ Comp->SetHiddenInGame(true); Comp->SetVisibility(false,true); Comp->SetRenderInMainPass(false); Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision); Comp->SetRenderCustomDepth(false); Comp->MarkRenderStateDirty(); }
+	// Validation only: parts are hidden on detach; this repairs (and logs) anything that drifted since
+	if (Assembly) Assembly->VerifyDetachedHidden();
 }
 
 void ARobotActor::OnAssemblyPartDetached(FName /*PartName*/, ARobotPartActor* /*SpawnedActor*/)
@@ -380,6 +426,14 @@ void ARobotActor::OnAssemblyPartDetached(FName /*PartName*/, ARobotPartActor* /*
 	UpdateStatusText(false);
 }
 
+void ARobotActor::OnAssemblyBuilt()
+{
+	// In CustomDepthStencil mode a build leaves every part outlined, which is the whole-robot outline state; seeding it
+	// lets the first part hover clear the rest in one pass. Hover state from before the build no longer applies.
+	HoverOutlineComp.Reset(); HoveredPartName = NAME_None;
+	bHoverOutlinesRobot = Assembly && Assembly->AssemblyConfig && Assembly->AssemblyConfig->HighlightMode == EHighlightMode::CustomDepthStencil;
+}
+
 void ARobotActor::OnAssemblyPartReattached(FName /*PartName*/)
 {
 	bool bAnyDetached=false; if (Assembly && Assembly->AssemblyConfig)
@@ -424,10 +478,11 @@ void ARobotActor::OnInteractPressed(UPrimitiveComponent* HitComponent, AActor* H
 			return;
 		}
 	}
-	if (PartInteraction && PartInteraction->HandleInteractPressed(HitComponent, HitActor, bAllowFreeAttach, AttachPosTolerance, AttachAngleToleranceDeg, PartGrabMinDistance, PartGrabMaxDistance)) { ShowPrompt(TEXT("Dragging part"),1.5f); return; }
+	const int32 HitItem = CachedTrace.IsValid() ? CachedTrace->GetHoveredItem() : INDEX_NONE;
+	if (PartInteraction && PartInteraction->HandleInteractPressed(HitComponent, HitActor, bAllowFreeAttach, AttachPosTolerance, AttachAngleToleranceDeg, PartGrabMinDistance, PartGrabMaxDistance, HitItem)) { ShowPrompt(TEXT("Dragging part"),1.5f); return; }
 	if (HitComponent && Assembly)
 	{
-		FName Part; if (Assembly->FindPartNameByComponent(HitComponent, Part) && Part == Part_Torso && bAllowTorsoDrag)
+		FName Part; if (Assembly->FindPartNameByHit(HitComponent, HitItem, Part) && Part == Part_Torso && bAllowTorsoDrag)
 		{
 			bDragging = !bDragging; if (bDragging){ DragPlaneZ=GetActorLocation().Z; FVector CursorWorld; if (ComputeCursorWorldOnPlane(DragPlaneZ, CursorWorld)) DragOffset = GetActorLocation()-CursorWorld; ShowPrompt(TEXT("Dragging robot"),1.5f);} else ShowPrompt(TEXT("Robot drag ended"),1.f); return;
 		}
@@ -457,14 +512,26 @@ void ARobotActor::ScrambleParts()
 		for (FName PName : PartNames)
 		{
 			if (Assembly->IsPartDetached(PName)) continue;
+			// Never re-parent onto the part itself or anything currently attached below it (attachment cycle)
+			TArray<FName, TInlineAllocator<8>> Exclude; Exclude.Add(PName); TArray<USceneComponent*> Below;
+			UStaticMeshComponent* PartComp = Assembly->IsPartInstanced(PName) ? nullptr : Assembly->GetPartByName(PName); // instanced parts are baked, no attachment
+			if (PartComp)
+			{
+				PartComp->GetChildrenComponents(true, Below); FName Child;
+				for (USceneComponent* C : Below) if (Assembly->FindPartNameByComponent(Cast<UPrimitiveComponent>(C), Child)) Exclude.Add(Child);
+				Below.Add(PartComp);
+			}
 			ARobotPartActor* TempActor=nullptr; if (Assembly->DetachPart(PName, TempActor) && TempActor)
 			{
 				USceneComponent* NewParent=nullptr; FName Socket=NAME_None; float Dist=0.f;
-				if (ScrambleSocketSearchRadius >0.f && Assembly->FindNearestAttachTarget(TempActor->GetActorLocation(), NewParent, Socket, Dist) && Dist <= ScrambleSocketSearchRadius)
+				if (ScrambleSocketSearchRadius >0.f && Assembly->FindNearestAttachTargetInRadius(TempActor->GetActorLocation(), ScrambleSocketSearchRadius, Exclude, NewParent, Socket, Dist))
 					Assembly->AttachDetachedPartTo(PName, TempActor, NewParent, Socket);
 				else
 				{
-					TArray<USceneComponent*> Targets; Assembly->GetAllAttachTargets(Targets); if (Targets.Num()>0){ NewParent = Targets[FMath::RandRange(0, Targets.Num()-1)]; Assembly->AttachDetachedPartTo(PName, TempActor, NewParent, NAME_None);} }
+					TArray<USceneComponent*> Targets; Assembly->GetAllAttachTargets(Targets); Targets.RemoveAll([&Below](const USceneComponent* T){ return Below.Contains(T); });
+					if (Targets.Num()>0){ NewParent = Targets[FMath::RandRange(0, Targets.Num()-1)]; Assembly->AttachDetachedPartTo(PName, TempActor, NewParent, NAME_None);}
+					else Assembly->ReattachPart(PName, TempActor);
+				}
 			}
 		}
 	}
@@ -516,8 +583,7 @@ bool ARobotActor::DetachPartForTest(FName PartName)
 bool ARobotActor::ReattachPartForTest(FName PartName)
 {
 	if (!Assembly || PartName.IsNone() || !Assembly->IsPartDetached(PartName)) return false;
-	for (TActorIterator<ARobotPartActor> It(GetWorld()); It; ++It) if (It->GetPartName()==PartName) return Assembly->ReattachPart(PartName, *It);
-	return false;
+	return Assembly->ReattachDetachedPart(PartName);
 }
 
 void ARobotActor::OnHighlightedChanged(bool bNowHighlighted)
@@ -570,17 +636,7 @@ void ARobotActor::ReattachAllDetached()
 	int32 Count=0;
 	for (const FRobotPartSpec& Spec : Assembly->AssemblyConfig->Parts)
 	{
-		if (Assembly->IsPartDetached(Spec.PartName))
-		{
-			for (TActorIterator<ARobotPartActor> It(GetWorld()); It; ++It)
-			{
-				if (It->GetPartName() == Spec.PartName)
-				{
-					if (Assembly->ReattachPart(Spec.PartName, *It)) ++Count;
-					break;
-				}
-			}
-		}
+		if (Assembly->IsPartDetached(Spec.PartName) && Assembly->ReattachDetachedPart(Spec.PartName)) ++Count;
 	}
 	ShowPrompt(FString::Printf(TEXT("Reattached %d"), Count),1.5f);
 }
@@ -14,6 +14,7 @@ ARobotPartActor::ARobotPartActor()
 void ARobotPartActor::InitializePart(FName InPartName, UStaticMesh* InMesh, const TArray<UMaterialInterface*>& InMaterials)
 {
 	PartName = InPartName;
+	Mesh->EmptyOverrideMaterials(); // recycled actors may carry a previous part's slots
 	if (InMesh)
 	{
 		Mesh->SetStaticMesh(InMesh);
@@ -24,6 +25,34 @@ void ARobotPartActor::InitializePart(FName InPartName, UStaticMesh* InMesh, cons
 	}
 }
 
+void ARobotPartActor::DeactivateToPool()
+{
+	bParked = true;
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	if (Mesh)
+	{
+		Mesh->SetSimulatePhysics(false);
+		Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Mesh->SetRenderCustomDepth(false);
+	}
+	if (Highlight) Highlight->SetHighlighted(false);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	PartName = NAME_None;
+	SetOwner(nullptr);
+}
+
+void ARobotPartActor::ActivateFromPool(const FTransform& Transform)
+{
+	bParked = false;
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	// Whoever held the actor last (e.g. a cinematic flight) may have switched overlaps off
+	const UStaticMeshComponent* DefaultMesh = GetDefault<ARobotPartActor>(GetClass())->GetMeshComponent();
+	if (Mesh && DefaultMesh) Mesh->SetGenerateOverlapEvents(DefaultMesh->GetGenerateOverlapEvents());
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+}
+
 void ARobotPartActor::EnablePhysics(bool bEnable)
 {
 	if (Mesh)
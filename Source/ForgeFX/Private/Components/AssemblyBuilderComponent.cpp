@@ -1,56 +1,175 @@
 #include "Components/AssemblyBuilderComponent.h"
+#include "ForgeFX.h"
+#include "Components/AssemblySocketRegistry.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Materials/MaterialInterface.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Actors/RobotPartActor.h"
+#include "Subsystems/RobotPartActorPool.h"
+#include "Subsystems/RobotAssemblySubsystem.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+static FTransform GetMeshSocketLocal(const UStaticMesh* Mesh, FName SocketName)
+{
+	if (const UStaticMeshSocket* Socket = (Mesh && !SocketName.IsNone()) ? Mesh->FindSocket(SocketName) : nullptr)
+	{
+		return FTransform(Socket->RelativeRotation, Socket->RelativeLocation, Socket->RelativeScale);
+	}
+	return FTransform::Identity;
+}
+
+// Detached (hidden) vs assembled render/collision state for component parts. Every setter is gated on the current
+// value so re-applying an already-correct state touches nothing; returns true only if some flag actually changed.
+static bool ApplyPartHiddenState(UStaticMeshComponent* Comp, bool bHidden, ECollisionEnabled::Type AssembledCollision)
+{
+	if (!Comp) return false;
+	bool bChanged = false;
+	if (Comp->bHiddenInGame != bHidden) { Comp->SetHiddenInGame(bHidden); bChanged = true; }
+	if (Comp->GetVisibleFlag() == bHidden) { Comp->SetVisibility(!bHidden, true); bChanged = true; }
+	if (Comp->bRenderInMainPass == bHidden) { Comp->SetRenderInMainPass(!bHidden); bChanged = true; }
+	const ECollisionEnabled::Type Collision = bHidden ? ECollisionEnabled::NoCollision : AssembledCollision;
+	if (Comp->GetCollisionEnabled() != Collision) { Comp->SetCollisionEnabled(Collision); bChanged = true; }
+	if (bHidden && Comp->bRenderCustomDepth) { Comp->SetRenderCustomDepth(false); bChanged = true; }
+	if (Comp->CastShadow == bHidden) { Comp->SetCastShadow(!bHidden); bChanged = true; }
+	if (Comp->bReceivesDecals == bHidden) { Comp->SetReceivesDecals(!bHidden); bChanged = true; }
+	if (Comp->IsComponentTickEnabled() == bHidden) Comp->SetComponentTickEnabled(!bHidden); // no render state involved
+	if (bChanged) { Comp->MarkRenderStateDirty(); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); }
+	return bChanged;
+}
+
+int32 FAssemblyPartTable::Add(FName Name, UStaticMeshComponent* Comp, EAssemblyPartFlags InFlags, FName InSocket)
+{
+	const int32 Handle = Names.Add(Name);
+	Components.Add(Comp);
+	DetachedActors.Add(nullptr);
+	MIDs.AddDefaulted();
+	BaseMaterials.AddDefaulted();
+	Flags.Add(InFlags);
+	ParentIndex.Add(INDEX_NONE);
+	Socket.Add(InSocket);
+	ParentOverride.AddDefaulted();
+	SocketOverride.Add(NAME_None);
+	CurrentHighlight.Add(0.f);
+	TargetHighlight.Add(0.f);
+	Instances.AddDefaulted();
+	NameToIndex.Add(Name, Handle);
+	if (Comp && !EnumHasAnyFlags(InFlags, EAssemblyPartFlags::Instanced)) ComponentToIndex.Add(Comp, Handle);
+	return Handle;
+}
+
+void FAssemblyPartTable::Reset()
+{
+	Names.Reset(); Components.Reset(); DetachedActors.Reset(); MIDs.Reset(); BaseMaterials.Reset(); Flags.Reset(); ParentIndex.Reset(); Socket.Reset();
+	ParentOverride.Reset(); SocketOverride.Reset(); CurrentHighlight.Reset(); TargetHighlight.Reset(); Instances.Reset(); NameToIndex.Reset(); ComponentToIndex.Reset();
+}
 
 UAssemblyBuilderComponent::UAssemblyBuilderComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Highlight interpolation is batched across robots by URobotAssemblySubsystem (joined from SetHighlightTarget)
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UAssemblyBuilderComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	// Robot destroyed, level change or PIE end: ClearAssembly never ran, so the counters are handed back here
+	ReleaseStatCounts();
+	Parts.Reset();
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+FTransform UAssemblyBuilderComponent::GetOwnerRootTransform() const
+{
+	const USceneComponent* Root = GetOwner() ? GetOwner()->GetRootComponent() : nullptr;
+	return Root ? Root->GetComponentTransform() : FTransform::Identity;
+}
+
+UInstancedStaticMeshComponent* UAssemblyBuilderComponent::GetInstancedComponent(int32 Handle) const
+{
+	return Parts.Has(Handle, EAssemblyPartFlags::Instanced) ? Cast<UInstancedStaticMeshComponent>(Parts.Components[Handle].Get()) : nullptr;
+}
+
+USceneComponent* UAssemblyBuilderComponent::ResolveSpecParent(int32 Handle) const
+{
+	USceneComponent* Root = GetOwner()->GetRootComponent();
+	const int32 ParentHandle = Parts.IsValid(Handle) ? Parts.ParentIndex[Handle] : INDEX_NONE;
+	USceneComponent* Parent = Parts.IsValid(ParentHandle) ? Parts.Components[ParentHandle].Get() : nullptr;
+	return Parent ? Parent : Root;
 }
 
-void UAssemblyBuilderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UAssemblyBuilderComponent::ApplyInstanceTransform(int32 Handle) const
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	// Enforce highlight interpolation if using scalar param
-	if (AssemblyConfig && AssemblyConfig->HighlightMode == EHighlightMode::MaterialParameter)
+	UInstancedStaticMeshComponent* ISMC = GetInstancedComponent(Handle); if (!ISMC) return;
+	// Hidden instances collapse to zero scale so indices (and hit items) stay stable
+	const FAssemblyPartInstance& Inst = Parts.Instances[Handle];
+	FTransform T = Inst.CurrentLocal; if (Parts.Has(Handle, EAssemblyPartFlags::Hidden)) T.SetScale3D(FVector::ZeroVector);
+	ISMC->UpdateInstanceTransform(Inst.InstanceIndex, T, false, true, true); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties);
+	SocketRegistry.MarkPartDirty(Handle); PartPicker.MarkPartDirty(Handle); ++TransformEpoch;
+}
+
+void UAssemblyBuilderComponent::StepHighlight(float DeltaTime)
+{
+	// Only parts still converging on their highlight target are visited; touches nothing but this table
+	HighlightDirty.Reset();
+	for (int32 k=AnimatingParts.Num()-1; k>=0; --k)
 	{
-		const FName Param = AssemblyConfig->HighlightScalarParam;
-		for (auto& Pair : DynamicMIDs)
-		{
-			UStaticMeshComponent* Comp = Cast<UStaticMeshComponent>(Pair.Key.Get()); if (!Comp) continue;
-			float* Curr = CurrentHighlight.Find(Comp); float* Tgt = TargetHighlight.Find(Comp);
-			const float CurrV = Curr ? *Curr :0.f; const float TgtV = Tgt ? *Tgt :0.f;
-			const float NewV = FMath::FInterpTo(CurrV, TgtV, DeltaTime, HighlightInterpSpeed);
-			CurrentHighlight.Add(Comp, NewV);
-			for (UMaterialInstanceDynamic* MID : Pair.Value.MIDs) if (MID) MID->SetScalarParameterValue(Param, NewV);
-		}
+		const int32 i = AnimatingParts[k];
+		const float Target = Parts.TargetHighlight[i];
+		float NewV = FMath::FInterpTo(Parts.CurrentHighlight[i], Target, DeltaTime, HighlightInterpSpeed);
+		const bool bConverged = FMath::IsNearlyEqual(NewV, Target, HighlightSettleTolerance);
+		if (bConverged) { NewV = Target; AnimatingParts.RemoveAtSwap(k, 1, EAllowShrinking::No); Parts.Set(i, EAssemblyPartFlags::Animating, false); }
+		if (NewV == Parts.CurrentHighlight[i]) continue;
+		Parts.CurrentHighlight[i] = NewV;
+		HighlightDirty.Add(i);
 	}
+}
 
-	// Ensure any parts marked detached remain fully hidden on the original component
-	for (const auto& Pair : DetachedParts)
+bool UAssemblyBuilderComponent::CommitHighlight()
+{
+	// Instanced parts: one render state dirty per ISMC
+	TSet<UInstancedStaticMeshComponent*, DefaultKeyFuncs<UInstancedStaticMeshComponent*>, TInlineSetAllocator<8>> DirtyISMCs;
+	for (const int32 i : HighlightDirty)
 	{
-		const FName PartName = Pair.Key;
-		if (UStaticMeshComponent* Comp = GetPartByName(PartName))
+		const float V = Parts.CurrentHighlight[i];
+		if (UInstancedStaticMeshComponent* ISMC = GetInstancedComponent(i))
 		{
-			Comp->SetHiddenInGame(true);
-			Comp->SetVisibility(false, true);
-			Comp->SetRenderInMainPass(false);
-			Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			Comp->SetRenderCustomDepth(false);
-			Comp->MarkRenderStateDirty();
+			ISMC->SetCustomDataValue(Parts.Instances[i].InstanceIndex, ForgeFXInstanceData::HighlightAmount, V, false);
+			DirtyISMCs.Add(ISMC);
 		}
+		else PushPartHighlight(i, V);
 	}
+	HighlightDirty.Reset();
+	for (UInstancedStaticMeshComponent* ISMC : DirtyISMCs) ISMC->MarkRenderStateDirty();
+	INC_DWORD_STAT_BY(STAT_ForgeFX_RenderStateDirties, DirtyISMCs.Num());
+	return AnimatingParts.Num() >0;
+}
+
+void UAssemblyBuilderComponent::PushPartHighlight(int32 Handle, float Value)
+{
+	UStaticMeshComponent* Comp = Parts.Components[Handle].Get(); if (!Comp) return;
+	if (UsesPrimitiveCustomData()) { Comp->SetCustomPrimitiveDataFloat(ForgeFXInstanceData::HighlightAmount, Value); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); return; }
+	const FName Param = AssemblyConfig ? AssemblyConfig->HighlightScalarParam : NAME_None;
+	for (UMaterialInstanceDynamic* MID : Parts.MIDs[Handle].MIDs) if (MID) MID->SetScalarParameterValue(Param, Value);
+}
+
+void UAssemblyBuilderComponent::SetHighlightTarget(int32 Handle, float Value)
+{
+	Parts.TargetHighlight[Handle] = Value;
+	if (Parts.CurrentHighlight[Handle] == Value || Parts.Has(Handle, EAssemblyPartFlags::Animating)) return;
+	Parts.Set(Handle, EAssemblyPartFlags::Animating, true); AnimatingParts.Add(Handle);
+	if (AnimatingParts.Num() ==1) if (URobotAssemblySubsystem* Batch = URobotAssemblySubsystem::Get(GetWorld())) Batch->AddHighlight(this);
 }
 
-void UAssemblyBuilderComponent::EnsureDynamicMIDs(UStaticMeshComponent* Comp)
+void UAssemblyBuilderComponent::EnsureDynamicMIDs(int32 Handle)
 {
-	if (!Comp) return;
-	if (DynamicMIDs.Contains(Comp)) return;
-	FDynamicMIDArray Arr;
+	UStaticMeshComponent* Comp = Parts.IsValid(Handle) ? Parts.Components[Handle].Get() : nullptr;
+	if (!Comp || UsesPrimitiveCustomData()) return; // custom data mode keeps the mesh's own materials (and cached draw commands)
+	FDynamicMIDArray& Arr = Parts.MIDs[Handle];
+	if (Arr.MIDs.Num() >0) return;
 	const int32 NumMats = Comp->GetNumMaterials();
 	for (int32 i=0; i<NumMats; ++i)
 	{
@@ -59,39 +178,60 @@ void UAssemblyBuilderComponent::EnsureDynamicMIDs(UStaticMeshComponent* Comp)
 		{
 			UMaterialInstanceDynamic* MID = UMaterialInstanceDynamic::Create(Mat, this);
 			Comp->SetMaterial(i, MID);
-			Arr.MIDs.Add(MID);
+			Arr.MIDs.Add(MID); INC_DWORD_STAT(STAT_ForgeFX_LiveMIDs);
 		}
 	}
-	DynamicMIDs.Add(Comp, MoveTemp(Arr));
+}
+
+void UAssemblyBuilderComponent::CacheBaseMaterials(int32 Handle)
+{
+	const UStaticMeshComponent* Comp = Parts.Components[Handle].Get();
+	TArray<TObjectPtr<UMaterialInterface>>& Materials = Parts.BaseMaterials[Handle].Materials; Materials.Reset();
+	if (Comp) for (int32 i=0; i<Comp->GetNumMaterials(); ++i) Materials.Add(Comp->GetMaterial(i));
+}
+
+void UAssemblyBuilderComponent::ReleaseStatCounts() const
+{
+#if STATS
+	for (int32 i=0; i<Parts.Num(); ++i)
+	{
+		DEC_DWORD_STAT_BY(STAT_ForgeFX_LiveMIDs, Parts.MIDs[i].MIDs.Num());
+		if (Parts.DetachedActors[i]) { DEC_DWORD_STAT(STAT_ForgeFX_DetachedActors); }
+	}
+#endif
 }
 
 void UAssemblyBuilderComponent::ClearAssembly()
 {
-	for (auto& Pair : NameToComponent)
+	ClearHoverOverride();
+	ReleaseStatCounts();
+	if (MeshLoadHandle.IsValid()) { MeshLoadHandle->CancelHandle(); MeshLoadHandle.Reset(); }
+	PendingMeshParts.Reset(); bAssemblyReady = false;
+	for (int32 i=0; i<Parts.Num(); ++i)
 	{
-		if (Pair.Value)
+		if (Parts.Components[i] && !Parts.Has(i, EAssemblyPartFlags::Instanced))
 		{
-			Pair.Value->DestroyComponent();
+			Parts.Components[i]->TransformUpdated.RemoveAll(this);
+			Parts.Components[i]->DestroyComponent();
 		}
 	}
-	NameToComponent.Empty();
-	ComponentToName.Empty();
-	PartAffectsHighlight.Empty();
-	DynamicMIDs.Empty();
-	DetachedParts.Empty();
-	DetachEnabledOverride.Empty();
-	CurrentHoverComp.Reset();
-	SavedMaterials.Empty();
+	for (auto& Pair : InstanceGroups)
+	{
+		if (Pair.Key) { Pair.Key->TransformUpdated.RemoveAll(this); Pair.Key->DestroyComponent(); }
+	}
+	Parts.Reset();
+	SocketRegistry.Reset(SocketGridCellSize);
+	PartPicker.Reset();
+	if (URobotAssemblySubsystem* Robots = URobotAssemblySubsystem::Get(GetWorld())) Robots->RemovePicker(this);
+	SocketWorldCache.Reset();
+	AnimatingParts.Reset(); HighlightDirty.Reset();
+	InstanceGroups.Empty();
 }
 
 void UAssemblyBuilderComponent::ApplyHighlightScalar(float Value)
 {
-	if (!AssemblyConfig || AssemblyConfig->HighlightMode != EHighlightMode::MaterialParameter) return;
-	for (auto& Pair : DynamicMIDs)
-	{
-		UStaticMeshComponent* Comp = Cast<UStaticMeshComponent>(Pair.Key.Get()); if (!Comp) continue;
-		TargetHighlight.Add(Comp, Value);
-	}
+	if (!DrivesHighlightAmount()) return;
+	for (int32 i=0; i<Parts.Num(); ++i) SetHighlightTarget(i, Value);
 }
 
 void UAssemblyBuilderComponent::ApplyHighlightScalarAll(float Value)
@@ -102,51 +242,201 @@ void UAssemblyBuilderComponent::ApplyHighlightScalarAll(float Value)
 
 void UAssemblyBuilderComponent::ApplyHighlightScalarToParts(const TArray<FName>& PartNames, float Value)
 {
-	if (!AssemblyConfig || AssemblyConfig->HighlightMode != EHighlightMode::MaterialParameter) return;
-	TSet<FName> Set(PartNames);
-	for (auto& Pair : DynamicMIDs)
+	if (!DrivesHighlightAmount()) return;
+	for (int32 i=0; i<Parts.Num(); ++i) SetHighlightTarget(i, 0.f);
+	for (const FName P : PartNames) { const int32 H = Parts.Find(P); if (H != INDEX_NONE) SetHighlightTarget(H, Value); }
+}
+
+void UAssemblyBuilderComponent::SetPartHighlightTarget(int32 Handle, float Value)
+{
+	if (!Parts.IsValid(Handle) || !DrivesHighlightAmount()) return;
+	SetHighlightTarget(Handle, Value);
+}
+
+void UAssemblyBuilderComponent::SetRenderCustomDepthAll(bool bEnable)
+{
+	for (int32 i=0; i<Parts.Num(); ++i)
 	{
-		UStaticMeshComponent* Comp = Cast<UStaticMeshComponent>(Pair.Key.Get()); if (!Comp) continue;
-		FName PartName = NAME_None; if (FName* N = ComponentToName.Find(Comp)) PartName = *N;
-		TargetHighlight.Add(Comp, Set.Contains(PartName) ? Value :0.f);
+		UStaticMeshComponent* Comp = Parts.Components[i].Get();
+		if (Comp && !Parts.Has(i, EAssemblyPartFlags::Instanced) && Comp->bRenderCustomDepth != bEnable) { Comp->SetRenderCustomDepth(bEnable); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); }
 	}
+	for (auto& Pair : InstanceGroups) if (Pair.Key && Pair.Key->bRenderCustomDepth != bEnable) { Pair.Key->SetRenderCustomDepth(bEnable); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); }
 }
 
 void UAssemblyBuilderComponent::BuildAssembly()
 {
+	FORGEFX_SCOPE(BuildAssembly);
 	ClearAssembly(); if (!AssemblyConfig) return;
+	TSet<FSoftObjectPath> MeshesToStream; // parts often share a mesh
+	if (bAsyncMeshLoading)
+	{
+		FRobotAssemblyBuildPlan& Plan = AssemblyConfig->GetBuildPlan();
+		for (int32 i=0; i<AssemblyConfig->Parts.Num(); ++i)
+		{
+			const FRobotPartSpec& Spec = AssemblyConfig->Parts[i];
+			if (!Spec.Mesh.IsNull() && !Plan.ResolveMesh(Spec, i, false)) MeshesToStream.Add(Spec.Mesh.ToSoftObjectPath());
+		}
+	}
+	if (MeshesToStream.Num() ==0) { BuildParts(false); FinishAssembly(); return; }
+
+	// Component parts are built now with empty meshes and filled in as loads land. Instanced parts are grouped by
+	// mesh and baked against parent mesh sockets, so that path builds once everything is resident.
+	if (!bUseInstancedComponents) BuildParts(true);
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MeshesToStream.Array(), FStreamableDelegate::CreateUObject(this, &UAssemblyBuilderComponent::OnPartMeshesLoaded));
+	if (bAssemblyReady) return; // everything was already resident and the delegate ran inline
+	MeshLoadHandle = Handle;
+	if (!MeshLoadHandle.IsValid()) { OnPartMeshesLoaded(); return; }
+	MeshLoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(this, &UAssemblyBuilderComponent::OnPartMeshLoadUpdate));
+	OnAssemblyLoadProgress.Broadcast(GetBuildProgress());
+}
+
+void UAssemblyBuilderComponent::OnPartMeshLoadUpdate(TSharedRef<FStreamableHandle> Handle)
+{
+	SwapInLoadedMeshes();
+	OnAssemblyLoadProgress.Broadcast(Handle->GetProgress());
+}
+
+void UAssemblyBuilderComponent::OnPartMeshesLoaded()
+{
+	if (Parts.Num() ==0) BuildParts(false); // instanced path deferred until now; meshes are resident so nothing blocks
+	else SwapInLoadedMeshes();
+	FinishAssembly();
+}
+
+void UAssemblyBuilderComponent::SwapInLoadedMeshes()
+{
+	bool bAnySwapped = false;
+	for (int32 k=PendingMeshParts.Num()-1; k>=0; --k)
+	{
+		const int32 Handle = PendingMeshParts[k];
+		const FRobotPartSpec* Spec = FindPartSpec(Parts.Names[Handle]);
+		UStaticMesh* Mesh = Spec ? Spec->Mesh.Get() : nullptr; if (!Mesh && Spec && !Spec->Mesh.IsNull()) continue;
+		PendingMeshParts.RemoveAtSwap(k, 1, EAllowShrinking::No);
+		UStaticMeshComponent* Comp = Parts.Components[Handle].Get(); if (!Comp) continue;
+		Comp->SetStaticMesh(Mesh);
+		EnsureDynamicMIDs(Handle); CacheBaseMaterials(Handle);
+		if (Parts.CurrentHighlight[Handle] !=0.f) PushPartHighlight(Handle, Parts.CurrentHighlight[Handle]);
+		Comp->UpdateChildTransforms(); // children attached to sockets that did not exist until now
+		bAnySwapped = true;
+	}
+	if (bAnySwapped) { RebuildSocketRegistry(); RebuildPartPicker(); } // socket entries and pick bounds come from the mesh
+}
+
+void UAssemblyBuilderComponent::ReleasePartActor(ARobotPartActor* PartActor) const
+{
+	if (URobotPartActorPool* Pool = bUsePartActorPool ? URobotPartActorPool::Get(GetWorld()) : nullptr) Pool->Release(PartActor);
+	else PartActor->Destroy();
+}
+
+void UAssemblyBuilderComponent::PrewarmPartActors() const
+{
+	URobotPartActorPool* Pool = bUsePartActorPool ? URobotPartActorPool::Get(GetWorld()) : nullptr;
+	if (!Pool || PartActorPrewarmCount <=0 || !AssemblyConfig) return;
+	TArray<UClass*, TInlineAllocator<4>> Classes;
 	for (const FRobotPartSpec& Spec : AssemblyConfig->Parts)
 	{
-		USceneComponent* Parent = nullptr; if (Spec.ParentPartName.IsNone()) Parent = GetOwner()->GetRootComponent(); else if (TObjectPtr<UStaticMeshComponent>* Found = NameToComponent.Find(Spec.ParentPartName)) Parent = Found->Get(); if (!Parent) Parent = GetOwner()->GetRootComponent();
+		if (Spec.bDetachable) Classes.AddUnique(Spec.DetachedActorClass ? Spec.DetachedActorClass.Get() : ARobotPartActor::StaticClass());
+	}
+	for (UClass* Class : Classes) Pool->Prewarm(Class, PartActorPrewarmCount);
+}
+
+void UAssemblyBuilderComponent::FinishAssembly()
+{
+	MeshLoadHandle.Reset(); PendingMeshParts.Reset();
+	bAssemblyReady = true;
+	PrewarmPartActors();
+	if (bUsePartPicker) if (URobotAssemblySubsystem* Robots = URobotAssemblySubsystem::Get(GetWorld())) Robots->AddPicker(this);
+	OnAssemblyLoadProgress.Broadcast(1.f);
+	OnAssemblyReady.Broadcast();
+}
+
+float UAssemblyBuilderComponent::GetBuildProgress() const
+{
+	if (bAssemblyReady) return 1.f;
+	return MeshLoadHandle.IsValid() ? MeshLoadHandle->GetProgress() :0.f;
+}
+
+void UAssemblyBuilderComponent::RebuildSocketRegistry()
+{
+	SocketRegistry.Reset(SocketGridCellSize);
+	for (int32 i=0; i<Parts.Num(); ++i)
+	{
+		const UStaticMeshComponent* Comp = Parts.Components[i].Get();
+		SocketRegistry.AddPart(i, Comp ? Comp->GetStaticMesh() : nullptr);
+	}
+}
+
+void UAssemblyBuilderComponent::RebuildPartPicker()
+{
+	PartPicker.Reset();
+	if (!bUsePartPicker) return;
+	for (int32 i=0; i<Parts.Num(); ++i)
+	{
+		const UStaticMeshComponent* Comp = Parts.Components[i].Get();
+		PartPicker.AddPart(i, Comp ? Comp->GetStaticMesh() : nullptr);
+	}
+}
+
+void UAssemblyBuilderComponent::BuildParts(bool bDeferUnloadedMeshes)
+{
+	// Replay the config's shared plan: parents come before children, so parent handles are already known
+	FRobotAssemblyBuildPlan& Plan = AssemblyConfig->GetBuildPlan();
+	TArray<int32> HandleBySpec; HandleBySpec.Init(INDEX_NONE, AssemblyConfig->Parts.Num());
+	TMap<UStaticMesh*, TObjectPtr<UInstancedStaticMeshComponent>> MeshToISMC;
+	for (const int32 SpecIndex : Plan.Order)
+	{
+		const FRobotPartSpec& Spec = AssemblyConfig->Parts[SpecIndex];
+		const int32 ParentSpec = Plan.ParentSpecIndex[SpecIndex];
+		const int32 ParentHandle = ParentSpec != INDEX_NONE ? HandleBySpec[ParentSpec] : INDEX_NONE;
+		EAssemblyPartFlags SpecFlags = EAssemblyPartFlags::None;
+		if (Spec.bAffectsHighlight) SpecFlags |= EAssemblyPartFlags::AffectsHighlight;
+		if (Spec.bDetachable) SpecFlags |= EAssemblyPartFlags::Detachable;
 
 		if (bUseInstancedComponents)
 		{
-			UInstancedStaticMeshComponent* ISMC = NewObject<UInstancedStaticMeshComponent>(GetOwner());
-			ISMC->SetMobility(EComponentMobility::Movable);
-			ISMC->SetStaticMesh(Spec.Mesh.LoadSynchronous());
-			ISMC->RegisterComponent();
-			ISMC->AttachToComponent(Parent, FAttachmentTransformRules::KeepRelativeTransform, Spec.ParentSocketName);
-			const int32 Index = ISMC->AddInstance(Spec.RelativeTransform);
-			// collision for hit-testing
-			ISMC->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-			ISMC->SetCollisionResponseToAllChannels(ECR_Ignore);
-			ISMC->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
-			// Store as if it were a static mesh component for lookups (cast at use sites accordingly)
-			UStaticMeshComponent* AsStatic = Cast<UStaticMeshComponent>(ISMC);
-			NameToComponent.Add(Spec.PartName, AsStatic);
-			ComponentToName.Add(AsStatic, Spec.PartName);
-			PartAffectsHighlight.Add(Spec.PartName, Spec.bAffectsHighlight);
-			// no dynamic MIDs path for ISMC here (material parameter highlight would need per-instance data)
-			CurrentHighlight.Add(AsStatic,0.f); TargetHighlight.Add(AsStatic,0.f);
+			UStaticMesh* Mesh = Plan.ResolveMesh(Spec, SpecIndex, true);
+			TObjectPtr<UInstancedStaticMeshComponent>& ISMC = MeshToISMC.FindOrAdd(Mesh);
+			if (!ISMC)
+			{
+				// One ISMC per unique mesh, attached to the root; part hierarchy is baked into instance transforms
+				ISMC = NewObject<UInstancedStaticMeshComponent>(GetOwner());
+				ISMC->SetMobility(EComponentMobility::Movable);
+				ISMC->SetStaticMesh(Mesh);
+				ISMC->SetNumCustomDataFloats(ForgeFXInstanceData::NumFloats);
+				ISMC->RegisterComponent();
+				ISMC->AttachToComponent(GetOwner()->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+				// collision for hit-testing (Hit.Item resolves the instance)
+				ISMC->SetCollisionEnabled(GetAssembledCollision());
+				ISMC->SetCollisionResponseToAllChannels(ECR_Ignore);
+				ISMC->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+				if (AssemblyConfig->HighlightMode == EHighlightMode::CustomDepthStencil) ISMC->SetCustomDepthStencilValue(AssemblyConfig->CustomDepthStencilValue);
+			}
+			FTransform ParentLocal = FTransform::Identity;
+			if (UInstancedStaticMeshComponent* ParentISMC = GetInstancedComponent(ParentHandle))
+			{
+				ParentLocal = GetMeshSocketLocal(ParentISMC->GetStaticMesh(), Spec.ParentSocketName) * Parts.Instances[ParentHandle].HomeLocal;
+			}
+			// Parts resolve to their shared ISMC for component-based lookups; use FindPartNameByHit for the reverse
+			const int32 Handle = Parts.Add(Spec.PartName, ISMC.Get(), SpecFlags | EAssemblyPartFlags::Instanced, Spec.ParentSocketName);
+			HandleBySpec[SpecIndex] = Handle; Parts.ParentIndex[Handle] = ParentHandle;
+			FAssemblyPartInstance& Inst = Parts.Instances[Handle];
+			Inst.HomeLocal = Spec.RelativeTransform * ParentLocal; Inst.CurrentLocal = Inst.HomeLocal;
+			Inst.InstanceIndex = ISMC->AddInstance(Inst.HomeLocal);
+			FInstancedPartGroup& Group = InstanceGroups.FindOrAdd(ISMC);
+			while (Group.PartByInstance.Num() <= Inst.InstanceIndex) Group.PartByInstance.Add(INDEX_NONE);
+			Group.PartByInstance[Inst.InstanceIndex] = Handle;
 		}
 		else
 		{
+			USceneComponent* Parent = Parts.IsValid(ParentHandle) ? Parts.Components[ParentHandle].Get() : nullptr; if (!Parent) Parent = GetOwner()->GetRootComponent();
 			UStaticMeshComponent* Comp = NewObject<UStaticMeshComponent>(GetOwner());
 			Comp->SetMobility(EComponentMobility::Movable);
 			Comp->RegisterComponent();
-			Comp->SetStaticMesh(Spec.Mesh.LoadSynchronous());
+			// While streaming, only take what is already resident; the rest is swapped in by SwapInLoadedMeshes
+			UStaticMesh* Mesh = Plan.ResolveMesh(Spec, SpecIndex, !bDeferUnloadedMeshes);
+			Comp->SetStaticMesh(Mesh);
 			Comp->SetRelativeTransform(Spec.RelativeTransform);
-			Comp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			Comp->SetCollisionEnabled(GetAssembledCollision());
 			Comp->SetCollisionResponseToAllChannels(ECR_Ignore);
 			Comp->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
 			if (AssemblyConfig->HighlightMode == EHighlightMode::CustomDepthStencil)
@@ -155,170 +445,320 @@ void UAssemblyBuilderComponent::BuildAssembly()
 				Comp->SetCustomDepthStencilValue(AssemblyConfig->CustomDepthStencilValue);
 				Comp->MarkRenderStateDirty();
 			}
-			EnsureDynamicMIDs(Comp);
-			CurrentHighlight.Add(Comp,0.f); TargetHighlight.Add(Comp,0.f);
+			const int32 Handle = Parts.Add(Spec.PartName, Comp, SpecFlags, Spec.ParentSocketName);
+			HandleBySpec[SpecIndex] = Handle; Parts.ParentIndex[Handle] = ParentHandle;
+			EnsureDynamicMIDs(Handle); CacheBaseMaterials(Handle);
+			if (!Mesh && !Spec.Mesh.IsNull()) PendingMeshParts.Add(Handle); // empty placeholder until its mesh lands
 			Comp->AttachToComponent(Parent, FAttachmentTransformRules::KeepRelativeTransform, Spec.ParentSocketName);
-			NameToComponent.Add(Spec.PartName, Comp); ComponentToName.Add(Comp, Spec.PartName); PartAffectsHighlight.Add(Spec.PartName, Spec.bAffectsHighlight);
 		}
 	}
+	SocketWorldCache.SetNum(Parts.Num());
+	// Attach point registry: entries refresh lazily, only for parts whose transform changed since the last query
+	RebuildSocketRegistry();
+	RebuildPartPicker();
+	for (int32 i=0; i<Parts.Num(); ++i)
+	{
+		UStaticMeshComponent* Comp = Parts.Components[i].Get();
+		if (Comp && !Parts.Has(i, EAssemblyPartFlags::Instanced)) Comp->TransformUpdated.AddUObject(this, &UAssemblyBuilderComponent::OnPartTransformUpdated, i);
+	}
+	for (auto& Pair : InstanceGroups) Pair.Key->TransformUpdated.AddUObject(this, &UAssemblyBuilderComponent::OnPartTransformUpdated, INDEX_NONE);
+}
+
+void UAssemblyBuilderComponent::OnPartTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags /*UpdateTransformFlags*/, ETeleportType /*Teleport*/, int32 Handle)
+{
+	++TransformEpoch; // invalidates same-frame socket transform cache entries
+	if (Handle != INDEX_NONE) { SocketRegistry.MarkPartDirty(Handle); PartPicker.MarkPartDirty(Handle); return; }
+	// Shared ISMC moved with the owner root: every instance it renders moved too
+	const FInstancedPartGroup* Group = InstanceGroups.Find(Cast<UInstancedStaticMeshComponent>(UpdatedComponent)); if (!Group) return;
+	for (const int32 Part : Group->PartByInstance) { SocketRegistry.MarkPartDirty(Part); PartPicker.MarkPartDirty(Part); }
+}
+
+void UAssemblyBuilderComponent::RefreshSocketRegistry() const
+{
+	if (!SocketRegistry.HasDirty()) return;
+	const FTransform RootWorld = GetOwnerRootTransform();
+	SocketRegistry.Refresh([this, &RootWorld](int32 Part){ return ComputePartWorld(Part, RootWorld); });
+}
+
+FTransform UAssemblyBuilderComponent::ComputePartWorld(int32 Handle, const FTransform& RootWorld) const
+{
+	if (Parts.Has(Handle, EAssemblyPartFlags::Instanced)) return Parts.Instances[Handle].CurrentLocal * RootWorld;
+	const UStaticMeshComponent* Comp = Parts.Components[Handle].Get();
+	return Comp ? Comp->GetComponentTransform() : RootWorld;
+}
+
+bool UAssemblyBuilderComponent::PickPart(const FVector& Start, const FVector& End, int32& OutHandle, FVector& OutLocation, float& OutDistance) const
+{
+	if (!bUsePartPicker || PartPicker.Num() ==0) return false;
+	if (PartPicker.HasDirty())
+	{
+		const FTransform RootWorld = GetOwnerRootTransform();
+		PartPicker.Refresh([this, &RootWorld](int32 Part){ return ComputePartWorld(Part, RootWorld); });
+	}
+	OutHandle = PartPicker.Raycast(Start, End, [this](int32 Part){ return !Parts.Has(Part, EAssemblyPartFlags::Detached | EAssemblyPartFlags::Hidden); }, OutLocation, OutDistance);
+	return OutHandle != INDEX_NONE;
 }
 
 UStaticMeshComponent* UAssemblyBuilderComponent::GetPartByName(FName PartName) const
 {
-	if (const TObjectPtr<UStaticMeshComponent>* Found = NameToComponent.Find(PartName)) return Found->Get();
-	return nullptr;
+	return GetPartComponentByHandle(Parts.Find(PartName));
 }
 
 bool UAssemblyBuilderComponent::FindPartNameByComponent(const UPrimitiveComponent* Comp, FName& OutName) const
 {
-	if (const FName* Found = ComponentToName.Find(Cast<UStaticMeshComponent>(Comp))) { OutName = *Found; return true; }
+	if (!Comp || Cast<UInstancedStaticMeshComponent>(Comp)) return false; // shared ISMCs are ambiguous; use FindPartNameByHit
+	if (const int32* Handle = Parts.ComponentToIndex.Find(Comp)) { OutName = Parts.Names[*Handle]; return true; }
+	return false;
+}
+
+bool UAssemblyBuilderComponent::FindPartNameByHit(const UPrimitiveComponent* Comp, int32 HitItem, FName& OutName) const
+{
+	if (const UInstancedStaticMeshComponent* ISMC = Cast<UInstancedStaticMeshComponent>(Comp))
+	{
+		if (const FInstancedPartGroup* Group = InstanceGroups.Find(const_cast<UInstancedStaticMeshComponent*>(ISMC)))
+		{
+			const int32 Handle = Group->PartByInstance.IsValidIndex(HitItem) ? Group->PartByInstance[HitItem] : INDEX_NONE;
+			if (Parts.IsValid(Handle)) { OutName = Parts.Names[Handle]; return true; }
+			return false;
+		}
+	}
+	return FindPartNameByComponent(Comp, OutName);
+}
+
+bool UAssemblyBuilderComponent::GetPartWorldTransform(FName PartName, FTransform& OutTransform) const
+{
+	const int32 Handle = Parts.Find(PartName); if (Handle == INDEX_NONE) return false;
+	if (Parts.Has(Handle, EAssemblyPartFlags::Instanced)) { OutTransform = Parts.Instances[Handle].CurrentLocal * GetOwnerRootTransform(); return true; }
+	if (const UStaticMeshComponent* Comp = Parts.Components[Handle].Get()) { OutTransform = Comp->GetComponentTransform(); return true; }
 	return false;
 }
 
 bool UAssemblyBuilderComponent::GetPartSpec(FName PartName, FRobotPartSpec& OutSpec) const
 {
-	if (!AssemblyConfig) return false;
-	if (const FRobotPartSpec* Spec = AssemblyConfig->Parts.FindByPredicate([&](const FRobotPartSpec& S){ return S.PartName==PartName; })) { OutSpec = *Spec; return true; }
+	if (const FRobotPartSpec* Spec = FindPartSpec(PartName)) { OutSpec = *Spec; return true; }
 	return false;
 }
 
 bool UAssemblyBuilderComponent::GetAttachParentAndSocket(FName PartName, USceneComponent*& OutParent, FName& OutSocket) const
 {
 	OutParent = nullptr; OutSocket = NAME_None;
-	FRobotPartSpec SpecTemp; if (!GetPartSpec(PartName, SpecTemp)) return false;
-	if (SpecTemp.ParentPartName.IsNone()) OutParent = GetOwner()->GetRootComponent();
-	else if (const TObjectPtr<UStaticMeshComponent>* Found = NameToComponent.Find(SpecTemp.ParentPartName)) OutParent = Found->Get();
-	if (!OutParent) OutParent = GetOwner()->GetRootComponent();
-	OutSocket = SpecTemp.ParentSocketName; return true;
+	const int32 Handle = Parts.Find(PartName); if (Handle == INDEX_NONE) return false;
+	OutParent = ResolveSpecParent(Handle);
+	OutSocket = Parts.Socket[Handle]; return true;
+}
+
+bool UAssemblyBuilderComponent::GetAttachSocketWorldTransform(FName PartName, FTransform& OutSocketWorld) const
+{
+	const int32 Handle = Parts.Find(PartName); if (Handle == INDEX_NONE) return false;
+	// Snap preview, snap readiness and snapping all ask for the same socket during a drag: compute it once per frame
+	FSocketWorldCacheEntry& Cached = SocketWorldCache[Handle];
+	if (Cached.Frame == GFrameCounter && Cached.Epoch == TransformEpoch) { OutSocketWorld = Cached.World; return true; }
+	const int32 ParentHandle = Parts.ParentIndex[Handle];
+	if (UInstancedStaticMeshComponent* ParentISMC = GetInstancedComponent(ParentHandle))
+	{
+		OutSocketWorld = GetMeshSocketLocal(ParentISMC->GetStaticMesh(), Parts.Socket[Handle]) * Parts.Instances[ParentHandle].CurrentLocal * GetOwnerRootTransform();
+	}
+	else
+	{
+		USceneComponent* Parent = ResolveSpecParent(Handle); if (!Parent) return false;
+		OutSocketWorld = Parent->GetSocketTransform(Parts.Socket[Handle], RTS_World);
+	}
+	Cached.Frame = GFrameCounter; Cached.Epoch = TransformEpoch; Cached.World = OutSocketWorld;
+	return true;
 }
 
 bool UAssemblyBuilderComponent::SetPartVisibility(FName PartName, bool bVisible)
 {
-	if (UStaticMeshComponent* Comp = GetPartByName(PartName)) { Comp->SetVisibility(bVisible, true); return true; }
+	const int32 Handle = Parts.Find(PartName); if (Handle == INDEX_NONE) return false;
+	if (Parts.Has(Handle, EAssemblyPartFlags::Instanced)) { Parts.Set(Handle, EAssemblyPartFlags::Hidden, !bVisible); ApplyInstanceTransform(Handle); return true; }
+	if (UStaticMeshComponent* Comp = Parts.Components[Handle].Get()) { Comp->SetVisibility(bVisible, true); return true; }
 	return false;
 }
 
 bool UAssemblyBuilderComponent::GetPartWorldLocation(FName PartName, FVector& OutLocation) const
 {
-	if (const UStaticMeshComponent* Comp = GetPartByName(PartName)) { OutLocation = Comp->GetComponentLocation(); return true; }
-	return false;
+	FTransform T; if (!GetPartWorldTransform(PartName, T)) return false;
+	OutLocation = T.GetLocation(); return true;
+}
+
+bool UAssemblyBuilderComponent::IsDetachableNow(int32 Handle) const
+{
+	if (Parts.Has(Handle, EAssemblyPartFlags::DetachOverride)) return Parts.Has(Handle, EAssemblyPartFlags::DetachEnabled);
+	return Parts.Has(Handle, EAssemblyPartFlags::Detachable);
 }
 
 bool UAssemblyBuilderComponent::IsDetachableNow(FName PartName) const
 {
-	if (const bool* Override = DetachEnabledOverride.Find(PartName)) return *Override;
-	FRobotPartSpec Spec; if (GetPartSpec(PartName, Spec)) return Spec.bDetachable; return false;
+	return IsDetachableNow(Parts.Find(PartName));
 }
 
 void UAssemblyBuilderComponent::SetDetachEnabledForParts(const TArray<FName>& PartNames, bool bEnabled)
 {
-	for (const FName P : PartNames) { DetachEnabledOverride.Add(P, bEnabled); }
+	for (const FName P : PartNames)
+	{
+		const int32 Handle = Parts.Find(P); if (Handle == INDEX_NONE) continue;
+		Parts.Set(Handle, EAssemblyPartFlags::DetachOverride, true); Parts.Set(Handle, EAssemblyPartFlags::DetachEnabled, bEnabled);
+	}
 }
 
 void UAssemblyBuilderComponent::SetDetachEnabledForAll(bool bEnabled)
 {
-	DetachEnabledOverride.Empty();
-	if (!AssemblyConfig) return;
-	for (const FRobotPartSpec& Spec : AssemblyConfig->Parts) { DetachEnabledOverride.Add(Spec.PartName, bEnabled); }
+	for (int32 i=0; i<Parts.Num(); ++i) { Parts.Set(i, EAssemblyPartFlags::DetachOverride, true); Parts.Set(i, EAssemblyPartFlags::DetachEnabled, bEnabled); }
 }
 
 bool UAssemblyBuilderComponent::DetachPart(FName PartName, ARobotPartActor*& OutActor)
 {
+	FORGEFX_SCOPE(DetachPart);
 	OutActor = nullptr; if (!AssemblyConfig) return false;
-	if (!IsDetachableNow(PartName)) return false;
-	UStaticMeshComponent* Comp = GetPartByName(PartName); if (!Comp) return false;
-	FRobotPartSpec Spec; if (!GetPartSpec(PartName, Spec)) return false;
+	const int32 Handle = Parts.Find(PartName);
+	if (!IsDetachableNow(Handle)) return false;
+	if (Parts.Has(Handle, EAssemblyPartFlags::Detached)) return false; // the registered actor would be orphaned
+	UStaticMeshComponent* Comp = Parts.Components[Handle].Get(); if (!Comp) return false;
+	if (!bAssemblyReady) return false; // meshes still streaming
+	const FRobotPartSpec* SpecPtr = FindPartSpec(PartName); if (!SpecPtr) return false;
+	const FRobotPartSpec& Spec = *SpecPtr;
 	UWorld* World = GetWorld(); if (!World) return false;
 	UStaticMesh* Mesh = Comp->GetStaticMesh();
 	TArray<UMaterialInterface*> Materials; for (int32 i=0, n=Comp->GetNumMaterials(); i<n; ++i) Materials.Add(Comp->GetMaterial(i));
 	TSubclassOf<ARobotPartActor> ClassToSpawn = Spec.DetachedActorClass ? Spec.DetachedActorClass : TSubclassOf<ARobotPartActor>(ARobotPartActor::StaticClass());
-	OutActor = World->SpawnActor<ARobotPartActor>(ClassToSpawn, Comp->GetComponentTransform()); if (!OutActor) return false;
+	FTransform SpawnTransform; GetPartWorldTransform(PartName, SpawnTransform);
+	URobotPartActorPool* Pool = bUsePartActorPool ? URobotPartActorPool::Get(World) : nullptr;
+	OutActor = Pool ? Pool->Acquire(ClassToSpawn, SpawnTransform) : World->SpawnActor<ARobotPartActor>(ClassToSpawn, SpawnTransform); if (!OutActor) return false;
 	OutActor->InitializePart(PartName, Mesh, Materials);
+	OutActor->SetOwner(GetOwner()); // holders (drag, cinematic) check this assembly's registry to see if it is still theirs
 	OutActor->GetMeshComponent()->SetCollisionProfileName(Spec.DetachedCollisionProfile);
 	OutActor->EnablePhysics(Spec.bSimulatePhysicsWhenDetached);
-	// Hide/disable original
-	Comp->SetHiddenInGame(true);
-	Comp->SetVisibility(false, true);
-	Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	Comp->SetRenderCustomDepth(false);
-	Comp->SetCastShadow(false);
-	Comp->SetReceivesDecals(false);
-	Comp->SetComponentTickEnabled(false);
-	Comp->MarkRenderStateDirty();
-	DetachedParts.Add(PartName, OutActor);
+	if (Parts.Has(Handle, EAssemblyPartFlags::Instanced))
+	{
+		// Shared ISMC stays visible for the other parts; only this instance collapses
+		Parts.Set(Handle, EAssemblyPartFlags::Hidden, true); ApplyInstanceTransform(Handle);
+	}
+	else
+	{
+		// Hide/disable original once, on the transition
+		ApplyPartHiddenState(Comp, true, GetAssembledCollision());
+	}
+	Parts.Set(Handle, EAssemblyPartFlags::Detached, true); Parts.DetachedActors[Handle] = OutActor; INC_DWORD_STAT(STAT_ForgeFX_DetachedActors);
 	OnRobotPartDetach.Broadcast(PartName, OutActor);
 	return true;
 }
 
+void UAssemblyBuilderComponent::ShowComponentPart(UStaticMeshComponent* Comp) const
+{
+	if (!ApplyPartHiddenState(Comp, false, GetAssembledCollision())) return;
+	// Visibility propagates down the attachment tree, so re-hide children that are still detached
+	TArray<USceneComponent*> Children; Comp->GetChildrenComponents(true, Children);
+	for (USceneComponent* Child : Children)
+	{
+		const int32* Handle = Parts.ComponentToIndex.Find(Cast<UPrimitiveComponent>(Child));
+		if (Handle && Parts.Has(*Handle, EAssemblyPartFlags::Detached)) ApplyPartHiddenState(Parts.Components[*Handle].Get(), true, GetAssembledCollision());
+	}
+}
+
+ARobotPartActor* UAssemblyBuilderComponent::GetDetachedActor(FName PartName) const
+{
+	const int32 Handle = Parts.Find(PartName);
+	return Parts.IsValid(Handle) ? Parts.DetachedActors[Handle].Get() : nullptr;
+}
+
+bool UAssemblyBuilderComponent::ReattachDetachedPart(FName PartName)
+{
+	ARobotPartActor* PartActor = GetDetachedActor(PartName);
+	return PartActor && ReattachPart(PartName, PartActor);
+}
+
 bool UAssemblyBuilderComponent::ReattachPart(FName PartName, ARobotPartActor* PartActor)
 {
-	if (!PartActor) return false; UStaticMeshComponent* Comp = GetPartByName(PartName); if (!Comp) return false;
-	FRobotPartSpec Spec; if (!GetPartSpec(PartName, Spec)) return false;
-	USceneComponent* Parent = nullptr; if (Spec.ParentPartName.IsNone()) Parent = GetOwner()->GetRootComponent();
-	else if (TObjectPtr<UStaticMeshComponent>* Found = NameToComponent.Find(Spec.ParentPartName)) Parent = Found->Get();
-	if (!Parent) Parent = GetOwner()->GetRootComponent();
-	if (Parent == Comp) { Parent = GetOwner()->GetRootComponent(); }
-	// Restore original
-	Comp->SetHiddenInGame(false);
-	Comp->SetVisibility(true, true);
-	Comp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	Comp->SetCastShadow(true);
-	Comp->SetReceivesDecals(true);
-	Comp->SetComponentTickEnabled(true);
-	Comp->AttachToComponent(Parent, FAttachmentTransformRules::SnapToTargetIncludingScale, Spec.ParentSocketName);
-	Comp->MarkRenderStateDirty();
-	PartActor->Destroy(); DetachedParts.Remove(PartName); OnRobotPartReattach.Broadcast(PartName);
+	FORGEFX_SCOPE(ReattachPart);
+	const int32 Handle = Parts.Find(PartName);
+	if (!PartActor || !Parts.Has(Handle, EAssemblyPartFlags::Detached)) return false; // already back (e.g. reattached while being dragged)
+	if (Parts.DetachedActors[Handle] && Parts.DetachedActors[Handle] != PartActor) return false; // not our actor for this part
+	UStaticMeshComponent* Comp = GetPartComponentByHandle(Handle); if (!Comp) return false;
+	if (Parts.Has(Handle, EAssemblyPartFlags::Instanced))
+	{
+		Parts.Instances[Handle].CurrentLocal = Parts.Instances[Handle].HomeLocal; Parts.Set(Handle, EAssemblyPartFlags::Hidden, false); ApplyInstanceTransform(Handle);
+	}
+	else
+	{
+		USceneComponent* Parent = ResolveSpecParent(Handle);
+		if (Parent == Comp) { Parent = GetOwner()->GetRootComponent(); }
+		// Restore original
+		ShowComponentPart(Comp);
+		Comp->AttachToComponent(Parent, FAttachmentTransformRules::SnapToTargetIncludingScale, Parts.Socket[Handle]);
+	}
+	ReleasePartActor(PartActor);
+	if (Parts.DetachedActors[Handle]) { DEC_DWORD_STAT(STAT_ForgeFX_DetachedActors); }
+	Parts.Set(Handle, EAssemblyPartFlags::Detached, false); Parts.DetachedActors[Handle] = nullptr;
+	Parts.ParentOverride[Handle].Reset(); Parts.SocketOverride[Handle] = NAME_None;
+	OnRobotPartReattach.Broadcast(PartName);
 	return true;
 }
 
 bool UAssemblyBuilderComponent::AttachDetachedPartTo(FName PartName, ARobotPartActor* PartActor, USceneComponent* NewParent, FName SocketName)
 {
 	if (!PartActor || !NewParent) return false;
-	UStaticMeshComponent* Comp = GetPartByName(PartName);
+	const int32 Handle = Parts.Find(PartName);
+	if (!Parts.Has(Handle, EAssemblyPartFlags::Detached) || (Parts.DetachedActors[Handle] && Parts.DetachedActors[Handle] != PartActor)) return false;
+	UStaticMeshComponent* Comp = GetPartComponentByHandle(Handle);
 	if (!Comp) return false;
-	if (NewParent == Comp) { NewParent = GetOwner()->GetRootComponent(); SocketName = NAME_None; } // avoid self-attach
-	Comp->SetHiddenInGame(false);
-	Comp->SetVisibility(true, true);
-	Comp->SetRenderInMainPass(true);
-	Comp->AttachToComponent(NewParent, FAttachmentTransformRules::SnapToTargetIncludingScale, SocketName);
-	Comp->MarkRenderStateDirty();
-	PartActor->Destroy();
-	DetachedParts.Remove(PartName);
-	ParentOverride.Add(PartName, NewParent);
-	SocketOverride.Add(PartName, SocketName);
+	if (Parts.Has(Handle, EAssemblyPartFlags::Instanced))
+	{
+		// Snap the instance to the target socket; shared ISMC parents resolve to the instance whose socket is nearest
+		const FTransform RootWorld = GetOwnerRootTransform();
+		FTransform TargetWorld = NewParent->GetSocketTransform(SocketName, RTS_World);
+		UInstancedStaticMeshComponent* ParentISMC = Cast<UInstancedStaticMeshComponent>(NewParent);
+		if (const FInstancedPartGroup* Group = ParentISMC ? InstanceGroups.Find(ParentISMC) : nullptr)
+		{
+			const FTransform SocketLocal = GetMeshSocketLocal(ParentISMC->GetStaticMesh(), SocketName);
+			const FVector At = PartActor->GetActorLocation(); float BestD = TNumericLimits<float>::Max();
+			for (const int32 Other : Group->PartByInstance)
+			{
+				if (!Parts.IsValid(Other) || Other == Handle || Parts.Has(Other, EAssemblyPartFlags::Hidden)) continue;
+				const FTransform W = SocketLocal * Parts.Instances[Other].CurrentLocal * RootWorld;
+				const float D = FVector::DistSquared(At, W.GetLocation()); if (D < BestD) { BestD = D; TargetWorld = W; }
+			}
+		}
+		Parts.Instances[Handle].CurrentLocal = TargetWorld.GetRelativeTransform(RootWorld); Parts.Set(Handle, EAssemblyPartFlags::Hidden, false); ApplyInstanceTransform(Handle);
+	}
+	else
+	{
+		if (NewParent == Comp) { NewParent = GetOwner()->GetRootComponent(); SocketName = NAME_None; } // avoid self-attach
+		ShowComponentPart(Comp);
+		Comp->AttachToComponent(NewParent, FAttachmentTransformRules::SnapToTargetIncludingScale, SocketName);
+	}
+	ReleasePartActor(PartActor);
+	if (Parts.DetachedActors[Handle]) { DEC_DWORD_STAT(STAT_ForgeFX_DetachedActors); }
+	Parts.Set(Handle, EAssemblyPartFlags::Detached, false); Parts.DetachedActors[Handle] = nullptr;
+	Parts.ParentOverride[Handle] = NewParent;
+	Parts.SocketOverride[Handle] = SocketName;
 	return true;
 }
 
 bool UAssemblyBuilderComponent::FindNearestAttachTarget(const FVector& AtWorldLocation, USceneComponent*& OutParent, FName& OutSocket, float& OutDistance, FName ExcludePartName) const
 {
+	TArray<FName, TInlineAllocator<1>> Exclude; if (!ExcludePartName.IsNone()) Exclude.Add(ExcludePartName);
+	return FindNearestAttachTargetInRadius(AtWorldLocation, 0.f, Exclude, OutParent, OutSocket, OutDistance);
+}
+
+bool UAssemblyBuilderComponent::FindNearestAttachTargetInRadius(const FVector& AtWorldLocation, float Radius, TConstArrayView<FName> ExcludePartNames, USceneComponent*& OutParent, FName& OutSocket, float& OutDistance) const
+{
+	FORGEFX_SCOPE(FindNearestAttachTarget);
 	OutParent = nullptr; OutSocket = NAME_None; OutDistance = TNumericLimits<float>::Max();
-	for (const auto& Pair : NameToComponent)
-	{
-		const FName ThisPart = Pair.Key;
-		if (ExcludePartName != NAME_None && ThisPart == ExcludePartName) continue; // avoid self
-		UStaticMeshComponent* Comp = Pair.Value.Get(); if (!Comp) continue;
-		{
-			const float D = FVector::Dist(AtWorldLocation, Comp->GetComponentLocation());
-			if (D < OutDistance) { OutDistance = D; OutParent = Comp; OutSocket = NAME_None; }
-		}
-		TArray<FName> Sockets = Comp->GetAllSocketNames();
-		for (const FName S : Sockets)
-		{
-			const FTransform T = Comp->GetSocketTransform(S, RTS_World);
-			const float D = FVector::Dist(AtWorldLocation, T.GetLocation());
-			if (D < OutDistance) { OutDistance = D; OutParent = Comp; OutSocket = S; }
-		}
-	}
+	TArray<int32, TInlineAllocator<8>> Exclude;
+	for (const FName Name : ExcludePartNames) { const int32 H = Parts.Find(Name); if (H != INDEX_NONE) Exclude.Add(H); } // avoid self
+	RefreshSocketRegistry();
+	float Dist =0.f;
+	const int32 Entry = SocketRegistry.FindNearest(AtWorldLocation, Radius, Exclude, Dist); if (Entry == INDEX_NONE) return false;
+	OutParent = Parts.Components[SocketRegistry.GetEntryPart(Entry)].Get(); OutSocket = SocketRegistry.GetEntrySocket(Entry); OutDistance = Dist;
 	return OutParent != nullptr;
 }
 
 void UAssemblyBuilderComponent::GetAllAttachTargets(TArray<USceneComponent*>& OutTargets) const
 {
-	OutTargets.Reset();
-	for (const auto& Pair : NameToComponent)
-	{
-		if (UStaticMeshComponent* Comp = Pair.Value.Get()) { OutTargets.Add(Comp); }
-	}
+	// Component parts are unique per part; instanced parts share one ISMC per group
+	OutTargets.Reset(Parts.ComponentToIndex.Num() + InstanceGroups.Num());
+	for (const TPair<const UPrimitiveComponent*, int32>& Pair : Parts.ComponentToIndex) if (UStaticMeshComponent* Comp = Parts.Components[Pair.Value]) OutTargets.Add(Comp);
+	for (const TPair<TObjectPtr<UInstancedStaticMeshComponent>, FInstancedPartGroup>& Pair : InstanceGroups) if (Pair.Key) OutTargets.Add(Pair.Key.Get());
 }
 
 bool UAssemblyBuilderComponent::IsDetachable(FName PartName) const
@@ -330,9 +770,9 @@ void UAssemblyBuilderComponent::RebuildAssembly()
 {
 	UE_LOG(LogTemp, Log, TEXT("AssemblyBuilder: RebuildAssembly invoked"));
 	BuildAssembly();
-	for (const auto& Pair : NameToComponent)
+	for (int32 i=0; i<Parts.Num(); ++i)
 	{
-		UE_LOG(LogTemp, Log, TEXT("AssemblyBuilder: Registered Part %s Component %s"), *Pair.Key.ToString(), *GetNameSafe(Pair.Value.Get()));
+		UE_LOG(LogTemp, Log, TEXT("AssemblyBuilder: Registered Part %s Component %s"), *Parts.Names[i].ToString(), *GetNameSafe(Parts.Components[i].Get()));
 	}
 	if (AssemblyConfig)
 	{
@@ -344,15 +784,32 @@ void UAssemblyBuilderComponent::RebuildAssembly()
 	}
 }
 
+int32 UAssemblyBuilderComponent::VerifyDetachedHidden()
+{
+	int32 Repaired = 0;
+	for (int32 i=0; i<Parts.Num(); ++i)
+	{
+		if (!Parts.Has(i, EAssemblyPartFlags::Detached)) continue;
+		if (Parts.Has(i, EAssemblyPartFlags::Instanced))
+		{
+			if (Parts.Has(i, EAssemblyPartFlags::Hidden)) continue;
+			Parts.Set(i, EAssemblyPartFlags::Hidden, true); ApplyInstanceTransform(i); ++Repaired;
+		}
+		else if (ApplyPartHiddenState(Parts.Components[i].Get(), true, GetAssembledCollision())) { ++Repaired; }
+	}
+	if (Repaired >0) UE_LOG(LogTemp, Warning, TEXT("AssemblyBuilder: Re-hid %d detached part(s) whose state drifted"), Repaired);
+	return Repaired;
+}
+
 void UAssemblyBuilderComponent::DumpState()
 {
 	UE_LOG(LogTemp, Log, TEXT("--- Assembly State ---"));
-	for (const auto& Pair : NameToComponent)
+	for (int32 i=0; i<Parts.Num(); ++i)
 	{
-		const FName P = Pair.Key;
-		UStaticMeshComponent* Comp = Pair.Value.Get();
+		const FName P = Parts.Names[i];
+		UStaticMeshComponent* Comp = Parts.Components[i].Get();
 		if (!Comp) continue;
-		const bool bDetached = DetachedParts.Contains(P);
+		const bool bDetached = Parts.Has(i, EAssemblyPartFlags::Detached);
 		// We cannot access internal bRenderInMainPass; approximate using visibility and hidden flags.
 		const bool bRenderApprox = Comp->IsVisible() && !Comp->bHiddenInGame;
 		UE_LOG(LogTemp, Log, TEXT("Part=%s Visible=%d HiddenInGame=%d RenderApprox=%d Detached=%d"), *P.ToString(), Comp->IsVisible()?1:0, Comp->bHiddenInGame?1:0, bRenderApprox?1:0, bDetached?1:0);
@@ -368,26 +825,63 @@ void UAssemblyBuilderComponent::ApplyHoverOverride(UPrimitiveComponent* HoveredC
 {
 	if (!bUseHoverHighlightMaterial || !HoveredComp || !HoverHighlightMaterial) return;
 	UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(HoveredComp); if (!MeshComp) return;
+	if (InstanceGroups.Contains(Cast<UInstancedStaticMeshComponent>(MeshComp))) return; // shared ISMC: custom data handles hover
+	if (UsesPrimitiveCustomData()) return; // hover rides on HighlightAmount; swapping materials would defeat cached draw commands
 	if (CurrentHoverComp.Get() == MeshComp) return;
 	ClearHoverOverride();
-	TArray<TObjectPtr<UMaterialInterface>> Originals; Originals.Reserve(MeshComp->GetNumMaterials());
-	for (int32 i=0;i<MeshComp->GetNumMaterials();++i) Originals.Add(MeshComp->GetMaterial(i));
-	SavedMaterials.Add(MeshComp, Originals);
-	for (int32 i=0;i<MeshComp->GetNumMaterials();++i) MeshComp->SetMaterial(i, HoverHighlightMaterial);
 	CurrentHoverComp = MeshComp;
+	if (bHoverOverlayMaterial)
+	{
+		HoverSavedOverlay = MeshComp->GetOverlayMaterial(); bHoverOverlayApplied = true;
+		MeshComp->SetOverlayMaterial(HoverHighlightMaterial); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties);
+		return;
+	}
+	const int32 NumMats = MeshComp->GetNumMaterials();
+	const int32* Handle = Parts.ComponentToIndex.Find(MeshComp); // null for detached part actors
+	if (Handle && Parts.BaseMaterials[*Handle].Materials.Num() == NumMats) HoverPartHandle = *Handle;
+	else { HoverSavedMaterials.Reset(); for (int32 i=0; i<NumMats; ++i) HoverSavedMaterials.Add(MeshComp->GetMaterial(i)); } // keeps its capacity
+	for (int32 i=0; i<NumMats; ++i) if (MeshComp->GetMaterial(i) != HoverHighlightMaterial) { MeshComp->SetMaterial(i, HoverHighlightMaterial); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); }
 }
 
 void UAssemblyBuilderComponent::ClearHoverOverride()
 {
-	if (!CurrentHoverComp.IsValid()) return;
 	UStaticMeshComponent* MeshComp = CurrentHoverComp.Get();
-	if (TArray<TObjectPtr<UMaterialInterface>>* Originals = SavedMaterials.Find(MeshComp))
+	if (MeshComp && bHoverOverlayApplied) { MeshComp->SetOverlayMaterial(HoverSavedOverlay); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); }
+	else if (MeshComp)
 	{
-		for (int32 i=0;i<MeshComp->GetNumMaterials() && i<Originals->Num(); ++i)
-		{
-			MeshComp->SetMaterial(i, (*Originals)[i]);
-		}
+		const TArray<TObjectPtr<UMaterialInterface>>& Originals = HoverPartHandle != INDEX_NONE ? Parts.BaseMaterials[HoverPartHandle].Materials : HoverSavedMaterials;
+		for (int32 i=0; i<MeshComp->GetNumMaterials() && i<Originals.Num(); ++i) if (MeshComp->GetMaterial(i) != Originals[i]) { MeshComp->SetMaterial(i, Originals[i]); INC_DWORD_STAT(STAT_ForgeFX_RenderStateDirties); }
 	}
-	SavedMaterials.Remove(MeshComp);
-	CurrentHoverComp.Reset();
+	CurrentHoverComp.Reset(); bHoverOverlayApplied = false; HoverPartHandle = INDEX_NONE; HoverSavedOverlay = nullptr;
+}
+
+bool UAssemblyBuilderComponent::SetPartSelected(FName PartName, bool bSelected)
+{
+	const int32 Handle = Parts.Find(PartName);
+	UInstancedStaticMeshComponent* ISMC = GetInstancedComponent(Handle);
+	if (!ISMC)
+	{
+		UStaticMeshComponent* Comp = UsesPrimitiveCustomData() && Parts.IsValid(Handle) ? Parts.Components[Handle].Get() : nullptr; if (!Comp) return false;
+		Comp->SetCustomPrimitiveDataFloat(ForgeFXInstanceData::Selected, bSelected ?1.f :0.f);
+		return true;
+	}
+	ISMC->SetCustomDataValue(Parts.Instances[Handle].InstanceIndex, ForgeFXInstanceData::Selected, bSelected ?1.f :0.f, true);
+	return true;
+}
+
+bool UAssemblyBuilderComponent::SetPartSnapColor(FName PartName, FLinearColor Color)
+{
+	const int32 Handle = Parts.Find(PartName);
+	UInstancedStaticMeshComponent* ISMC = GetInstancedComponent(Handle);
+	if (!ISMC)
+	{
+		UStaticMeshComponent* Comp = UsesPrimitiveCustomData() && Parts.IsValid(Handle) ? Parts.Components[Handle].Get() : nullptr; if (!Comp) return false;
+		Comp->SetCustomPrimitiveDataVector3(ForgeFXInstanceData::SnapColorR, FVector(Color.R, Color.G, Color.B));
+		return true;
+	}
+	const int32 Index = Parts.Instances[Handle].InstanceIndex;
+	ISMC->SetCustomDataValue(Index, ForgeFXInstanceData::SnapColorR, Color.R, false);
+	ISMC->SetCustomDataValue(Index, ForgeFXInstanceData::SnapColorG, Color.G, false);
+	ISMC->SetCustomDataValue(Index, ForgeFXInstanceData::SnapColorB, Color.B, true);
+	return true;
 }
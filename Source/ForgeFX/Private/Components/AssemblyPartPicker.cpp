@@ -0,0 +1,134 @@
+#include "Components/AssemblyPartPicker.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+
+void FAssemblyPartPicker::Reset()
+{
+	LocalMin.Reset(); LocalMax.Reset(); PartWorld.Reset(); PartWorldBox.Reset(); PartMesh.Reset(); PartDirty.Reset(); NumDirty =0;
+	WorldBounds.Init();
+	MeshCache.Reset();
+}
+
+void FAssemblyPartPicker::AddPart(int32 Part, const UStaticMesh* Mesh)
+{
+	check(Part == LocalMin.Num());
+	if (Mesh)
+	{
+		const FBox Box = Mesh->GetBoundingBox();
+		LocalMin.Add(FVector3f(Box.Min)); LocalMax.Add(FVector3f(Box.Max));
+	}
+	else
+	{
+		LocalMin.Add(FVector3f(1.f)); LocalMax.Add(FVector3f(-1.f));
+	}
+	PartWorld.Add(FTransform::Identity); PartWorldBox.Add(FBox(ForceInit));
+	PartMesh.Add(Mesh ? GetPickMesh(Mesh) : nullptr);
+	PartDirty.Add(true); ++NumDirty;
+}
+
+TSharedPtr<const FAssemblyPartPicker::FPickMesh> FAssemblyPartPicker::GetPickMesh(const UStaticMesh* Mesh)
+{
+	if (const TSharedPtr<const FPickMesh>* Found = MeshCache.Find(Mesh)) return *Found;
+	TSharedPtr<FPickMesh> Pick;
+	const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+	if (RenderData && RenderData->LODResources.Num() >0)
+	{
+		const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+		const FPositionVertexBuffer& PositionBuffer = LOD.VertexBuffers.PositionVertexBuffer;
+		// Cooked meshes without CPU access drop their vertex data after upload: box hits only
+		if (PositionBuffer.GetVertexData() && PositionBuffer.GetNumVertices() >0)
+		{
+			Pick = MakeShared<FPickMesh>();
+			Pick->Positions.SetNumUninitialized(PositionBuffer.GetNumVertices());
+			for (uint32 v=0; v<PositionBuffer.GetNumVertices(); ++v) Pick->Positions[v] = PositionBuffer.VertexPosition(v);
+			LOD.IndexBuffer.GetCopy(Pick->Indices);
+			if (Pick->Indices.Num() <3) Pick.Reset();
+		}
+	}
+	MeshCache.Add(Mesh, Pick);
+	return Pick;
+}
+
+void FAssemblyPartPicker::Refresh(TFunctionRef<FTransform(int32 Part)> GetPartWorld)
+{
+	if (NumDirty ==0) return;
+	for (TConstSetBitIterator<> It(PartDirty); It; ++It)
+	{
+		const int32 Part = It.GetIndex();
+		PartWorld[Part] = GetPartWorld(Part);
+		if (LocalMin[Part].X <= LocalMax[Part].X) PartWorldBox[Part] = FBox(FVector(LocalMin[Part]), FVector(LocalMax[Part])).TransformBy(PartWorld[Part]);
+	}
+	PartDirty.SetRange(0, PartDirty.Num(), false); NumDirty =0;
+	WorldBounds.Init(); for (const FBox& Box : PartWorldBox) WorldBounds += Box; // adding an invalid box is a no-op
+}
+
+bool FAssemblyPartPicker::SlabTest(int32 Part, const FVector3f& Origin, const FVector3f& Delta, float& OutT) const
+{
+	// Axes the ray runs parallel to get a huge finite reciprocal (never inf, so 0 * it stays 0)
+	auto SafeInv = [](float D){ return FMath::Abs(D) > SMALL_NUMBER ?1.f / D : (D <0.f ? -BIG_NUMBER : BIG_NUMBER); };
+	const FVector3f InvDelta(SafeInv(Delta.X), SafeInv(Delta.Y), SafeInv(Delta.Z));
+	const VectorRegister4Float O = VectorLoadFloat3(&Origin.X);
+	const VectorRegister4Float InvD = VectorLoadFloat3(&InvDelta.X);
+	const VectorRegister4Float T1 = VectorMultiply(VectorSubtract(VectorLoadFloat3(&LocalMin[Part].X), O), InvD);
+	const VectorRegister4Float T2 = VectorMultiply(VectorSubtract(VectorLoadFloat3(&LocalMax[Part].X), O), InvD);
+	alignas(16) float Near[4], Far[4];
+	VectorStoreAligned(VectorMin(T1, T2), Near); VectorStoreAligned(VectorMax(T1, T2), Far);
+	const float Enter = FMath::Max3(Near[0], Near[1], Near[2]), Exit = FMath::Min3(Far[0], Far[1], Far[2]);
+	if (Enter > Exit || Exit <0.f || Enter >1.f) return false;
+	OutT = FMath::Max(Enter,0.f);
+	return true;
+}
+
+bool FAssemblyPartPicker::TriangleTest(const FPickMesh& Mesh, const FVector3f& Origin, const FVector3f& Delta, float MaxT, float& OutT) const
+{
+	// Moller-Trumbore, double sided
+	bool bHit = false; float Best = MaxT;
+	for (int32 i=0; i +2 < Mesh.Indices.Num(); i +=3)
+	{
+		const FVector3f& A = Mesh.Positions[Mesh.Indices[i]];
+		const FVector3f E1 = Mesh.Positions[Mesh.Indices[i +1]] - A, E2 = Mesh.Positions[Mesh.Indices[i +2]] - A;
+		const FVector3f P = Delta ^ E2; const float Det = E1 | P;
+		if (FMath::Abs(Det) < KINDA_SMALL_NUMBER) continue;
+		const float InvDet =1.f / Det; const FVector3f S = Origin - A;
+		const float U = (S | P) * InvDet; if (U <0.f || U >1.f) continue;
+		const FVector3f Q = S ^ E1;
+		const float V = (Delta | Q) * InvDet; if (V <0.f || U + V >1.f) continue;
+		const float T = (E2 | Q) * InvDet;
+		if (T >=0.f && T < Best) { Best = T; bHit = true; }
+	}
+	if (bHit) OutT = Best;
+	return bHit;
+}
+
+int32 FAssemblyPartPicker::Raycast(const FVector& Start, const FVector& End, TFunctionRef<bool(int32 Part)> IsPickable, FVector& OutLocation, float& OutDistance) const
+{
+	// Whole assembly first: one box test instead of a transform and slab test per part for rays that pass it by
+	if (!WorldBounds.IsValid || !FMath::LineBoxIntersection(WorldBounds, Start, End, End - Start)) return INDEX_NONE;
+	// Broad phase: every pickable box, as (entry t, part)
+	TArray<TPair<float, int32>, TInlineAllocator<32>> Candidates;
+	for (int32 Part=0; Part<LocalMin.Num(); ++Part)
+	{
+		if (LocalMin[Part].X > LocalMax[Part].X || !IsPickable(Part)) continue; // no mesh yet
+		const FVector3f O(PartWorld[Part].InverseTransformPosition(Start));
+		const FVector3f D = FVector3f(PartWorld[Part].InverseTransformPosition(End)) - O;
+		float T; if (SlabTest(Part, O, D, T)) Candidates.Emplace(T, Part);
+	}
+	if (Candidates.Num() ==0) return INDEX_NONE;
+	Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B){ return A.Key < B.Key; });
+
+	// Narrow phase, nearest box first; stop once the next box starts beyond the best hit
+	int32 Best = INDEX_NONE; float BestT =1.f;
+	for (const TPair<float, int32>& Candidate : Candidates)
+	{
+		if (Best != INDEX_NONE && Candidate.Key >= BestT) break;
+		const int32 Part = Candidate.Value;
+		if (!HasTriangles(Part)) { Best = Part; BestT = Candidate.Key; continue; }
+		const FVector3f O(PartWorld[Part].InverseTransformPosition(Start));
+		const FVector3f D = FVector3f(PartWorld[Part].InverseTransformPosition(End)) - O;
+		float T; if (TriangleTest(*PartMesh[Part], O, D, BestT, T)) { Best = Part; BestT = T; }
+	}
+	if (Best == INDEX_NONE) return INDEX_NONE;
+	OutLocation = FMath::Lerp(Start, End, double(BestT));
+	OutDistance = float(FVector::Dist(Start, End) * BestT);
+	return Best;
+}
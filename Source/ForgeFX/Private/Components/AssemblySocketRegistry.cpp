@@ -0,0 +1,89 @@
+#include "Components/AssemblySocketRegistry.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+
+void FAssemblySocketRegistry::Reset(float InCellSize)
+{
+	EntryPart.Reset(); EntrySocket.Reset(); EntryLocal.Reset(); EntryWorld.Reset(); EntryCell.Reset(); EntryInGrid.Reset();
+	PartFirstEntry.Reset(); PartNumEntries.Reset(); PartDirty.Reset(); NumDirty =0;
+	Cells.Reset();
+	CellSize = FMath::Max(InCellSize, 1.f); InvCellSize =1.f / CellSize;
+}
+
+void FAssemblySocketRegistry::AddPart(int32 Part, const UStaticMesh* Mesh)
+{
+	check(Part == PartFirstEntry.Num());
+	auto AddEntry = [this, Part](FName Socket, const FVector& Local)
+	{
+		EntryPart.Add(Part); EntrySocket.Add(Socket); EntryLocal.Add(Local);
+		EntryWorld.Add(FVector::ZeroVector); EntryCell.Add(FIntVector::ZeroValue); EntryInGrid.Add(false);
+	};
+	PartFirstEntry.Add(EntryPart.Num());
+	AddEntry(NAME_None, FVector::ZeroVector);
+	if (Mesh)
+	{
+		for (const UStaticMeshSocket* S : Mesh->Sockets) if (S) AddEntry(S->SocketName, S->RelativeLocation);
+	}
+	PartNumEntries.Add(EntryPart.Num() - PartFirstEntry.Last());
+	PartDirty.Add(true); ++NumDirty;
+}
+
+void FAssemblySocketRegistry::MoveToCell(int32 Entry, const FIntVector& NewCell)
+{
+	if (EntryInGrid[Entry])
+	{
+		if (EntryCell[Entry] == NewCell) return;
+		if (TArray<int32, TInlineAllocator<8>>* Old = Cells.Find(EntryCell[Entry]))
+		{
+			Old->RemoveSingleSwap(Entry, EAllowShrinking::No);
+			if (Old->Num() ==0) Cells.Remove(EntryCell[Entry]);
+		}
+	}
+	Cells.FindOrAdd(NewCell).Add(Entry);
+	EntryCell[Entry] = NewCell; EntryInGrid[Entry] = true;
+}
+
+void FAssemblySocketRegistry::Refresh(TFunctionRef<FTransform(int32 Part)> GetPartWorld)
+{
+	if (NumDirty ==0) return;
+	for (TConstSetBitIterator<> It(PartDirty); It; ++It)
+	{
+		const int32 Part = It.GetIndex();
+		const FTransform World = GetPartWorld(Part);
+		for (int32 e=PartFirstEntry[Part], End=e + PartNumEntries[Part]; e<End; ++e)
+		{
+			EntryWorld[e] = World.TransformPosition(EntryLocal[e]);
+			MoveToCell(e, CellOf(EntryWorld[e]));
+		}
+	}
+	PartDirty.SetRange(0, PartDirty.Num(), false); NumDirty =0;
+}
+
+int32 FAssemblySocketRegistry::FindNearest(const FVector& At, float Radius, TConstArrayView<int32> ExcludeParts, float& OutDistance) const
+{
+	int32 Best = INDEX_NONE; double BestDSq = TNumericLimits<double>::Max();
+	auto Consider = [&](int32 e)
+	{
+		const double DSq = FVector::DistSquared(At, EntryWorld[e]);
+		if (DSq < BestDSq && !IsExcluded(e, ExcludeParts)) { BestDSq = DSq; Best = e; }
+	};
+	const FIntVector Min = Radius >0.f ? CellOf(At - FVector(Radius)) : FIntVector::ZeroValue;
+	const FIntVector Max = Radius >0.f ? CellOf(At + FVector(Radius)) : FIntVector::ZeroValue;
+	const int64 NumCellsInRange = int64(Max.X - Min.X +1) * (Max.Y - Min.Y +1) * (Max.Z - Min.Z +1);
+	if (Radius <=0.f || NumCellsInRange >= Cells.Num())
+	{
+		// Unbounded (or radius spans most of the grid): a linear pass over the packed positions is cheaper
+		for (int32 e=0; e<EntryWorld.Num(); ++e) Consider(e);
+	}
+	else
+	{
+		for (int32 X=Min.X; X<=Max.X; ++X) for (int32 Y=Min.Y; Y<=Max.Y; ++Y) for (int32 Z=Min.Z; Z<=Max.Z; ++Z)
+		{
+			if (const TArray<int32, TInlineAllocator<8>>* Cell = Cells.Find(FIntVector(X, Y, Z))) for (const int32 e : *Cell) Consider(e);
+		}
+	}
+	if (Best == INDEX_NONE) return INDEX_NONE;
+	OutDistance = float(FMath::Sqrt(BestDSq));
+	if (Radius >0.f && OutDistance > Radius) return INDEX_NONE;
+	return Best;
+}
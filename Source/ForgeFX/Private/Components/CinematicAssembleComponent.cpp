@@ -2,11 +2,17 @@
 #include "Components/AssemblyBuilderComponent.h"
 #include "Actors/RobotPartActor.h"
 #include "Actors/RobotActor.h"
-#include "EngineUtils.h"
+#include "Subsystems/RobotAssemblySubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarCinematicParallelMinParts(TEXT("ForgeFX.Cinematic.ParallelMinParts"), 64, TEXT("Minimum detached parts before a cinematic's lerp is split across worker threads (0 = never)."));
 
 UCinematicAssembleComponent::UCinematicAssembleComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Updated by URobotAssemblySubsystem while a cinematic is running
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 UAssemblyBuilderComponent* UCinematicAssembleComponent::GetAssembly() const
@@ -20,11 +26,12 @@ UAssemblyBuilderComponent* UCinematicAssembleComponent::GetAssembly() const
 
 void UCinematicAssembleComponent::BuildPartList()
 {
-	Parts.Reset();
-	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly || !Assembly->AssemblyConfig) return;
+	ResetPartList();
+	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly || !Assembly->AssemblyConfig || !ActiveSampler.IsValid()) return;
 	for (const FRobotPartSpec& Spec : Assembly->AssemblyConfig->Parts)
 	{
 		if (!Assembly->IsDetachable(Spec.PartName)) continue;
+		const int32 Track = ActiveSampler->FindTrack(Spec.PartName); if (Track == INDEX_NONE) continue; // not choreographed
 		ARobotPartActor* OutActor = nullptr;
 		if (!Assembly->IsPartDetached(Spec.PartName))
 		{
@@ -32,49 +39,101 @@ void UCinematicAssembleComponent::BuildPartList()
 		}
 		else
 		{
-			for (TActorIterator<ARobotPartActor> It(GetWorld()); It; ++It)
-			{
-				if (It->GetPartName()==Spec.PartName) { OutActor = *It; break; }
-			}
+			OutActor = Assembly->GetDetachedActor(Spec.PartName);
 		}
 		if (!OutActor) continue;
-		USceneComponent* Parent; FName Socket; FTransform SocketWorld = OutActor->GetActorTransform();
-		if (Assembly->GetAttachParentAndSocket(Spec.PartName, Parent, Socket) && Parent) SocketWorld = Parent->GetSocketTransform(Socket, RTS_World);
-		FCinePart CP; CP.Actor = OutActor; CP.TargetSocketWorld = SocketWorld; CP.ScatterDir = FVector(FMath::FRandRange(-1.f,1.f), FMath::FRandRange(-1.f,1.f), FMath::FRandRange(0.2f,1.f)).GetSafeNormal();
-		Parts.Add(CP);
+		FTransform SocketWorld = OutActor->GetActorTransform();
+		Assembly->GetAttachSocketWorldTransform(Spec.PartName, SocketWorld);
+		const FVector ScatterDir = FVector(FMath::FRandRange(-1.f,1.f), FMath::FRandRange(-1.f,1.f), FMath::FRandRange(0.2f,1.f)).GetSafeNormal();
+		// Parts fly through each other and the robot; overlap queries on every move are wasted work
+		UStaticMeshComponent* Mesh = OutActor->GetMeshComponent();
+		const bool bOverlaps = Mesh && Mesh->GetGenerateOverlapEvents(); if (bOverlaps) Mesh->SetGenerateOverlapEvents(false);
+		PartStartTimes.Add(ActiveSampler->StaggerPerPart * PartActors.Num());
+		PartActors.Add(OutActor); PartNames.Add(Spec.PartName); HomeLocations.Add(SocketWorld.GetLocation()); ScatterDirs.Add(ScatterDir); PartTracks.Add(Track);
+		RestoreOverlaps.Add(bOverlaps);
+	}
+	PendingLocations.SetNumUninitialized(PartActors.Num());
+}
+
+void UCinematicAssembleComponent::ResetPartList()
+{
+	for (int32 i=0; i<PartActors.Num(); ++i) RestoreOverlap(i);
+	PartActors.Reset(); PartNames.Reset(); HomeLocations.Reset(); ScatterDirs.Reset(); PartTracks.Reset(); PartStartTimes.Reset(); PendingLocations.Reset(); RestoreOverlaps.Reset();
+}
+
+void UCinematicAssembleComponent::RestoreOverlap(int32 Index)
+{
+	if (RestoreOverlaps[Index] && PartActors[Index]) if (UStaticMeshComponent* Mesh = PartActors[Index]->GetMeshComponent()) Mesh->SetGenerateOverlapEvents(true);
+	RestoreOverlaps[Index] = false;
+}
+
+void UCinematicAssembleComponent::DropReleasedParts(const UAssemblyBuilderComponent& Assembly)
+{
+	// A part reattached mid-flight (player snap, reattach all, showcase) sent its actor back to the pool, from where any
+	// robot's next detach may take it; only actors the registry still holds under their part name are moved
+	for (int32 i=PartActors.Num()-1; i>=0; --i)
+	{
+		ARobotPartActor* Actor = PartActors[i];
+		if (Actor && Assembly.GetDetachedActor(PartNames[i]) == Actor) continue;
+		// Reacquired actors were reset by ActivateFromPool and may be in another flight; only parked ones are restored
+		if (IsValid(Actor) && Actor->IsParked()) RestoreOverlap(i);
+		PartActors.RemoveAtSwap(i, 1, EAllowShrinking::No); PartNames.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		HomeLocations.RemoveAtSwap(i, 1, EAllowShrinking::No); ScatterDirs.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		PartTracks.RemoveAtSwap(i, 1, EAllowShrinking::No); PartStartTimes.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		PendingLocations.RemoveAtSwap(i, 1, EAllowShrinking::No); RestoreOverlaps.RemoveAtSwap(i);
 	}
 }
 
 void UCinematicAssembleComponent::TriggerAssemble(FVector NewLocation)
 {
 	if (Phase != ECinematicPhase::None) return; // ignore while active
-	BuildPartList(); if (Parts.Num()==0) return;
+	// Curve tables are baked here (or once per asset), never per frame
+	ActiveSampler = Timeline ? Timeline->GetSampler() : MakeShared<const FCinematicTimelineSampler>(FCinematicTimelineSampler::MakeScatterReturn(ScatterDuration, ReturnDuration, ScatterDistance, EasePower));
+	BuildPartList(); if (PartActors.Num()==0) { ActiveSampler.Reset(); return; }
 	BaseTarget = NewLocation; Phase = ECinematicPhase::Scatter; Elapsed =0.f;
+	RobotMove = BaseTarget - GetOwner()->GetActorLocation(); TotalDuration = ActiveSampler->GetTotalDuration(PartActors.Num());
+	if (URobotAssemblySubsystem* Batch = URobotAssemblySubsystem::Get(GetWorld())) Batch->AddCinematic(this);
 }
 
-void UCinematicAssembleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UCinematicAssembleComponent::StepCinematic(float DeltaTime)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	if (Phase == ECinematicPhase::None) return;
 	Elapsed += DeltaTime;
-	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly) return;
-	if (Phase == ECinematicPhase::Scatter)
+	const FCinematicTimelineSampler& Sampler = *ActiveSampler;
+	const FVector* Home = HomeLocations.GetData(); const FVector* Dir = ScatterDirs.GetData();
+	const int32* Track = PartTracks.GetData(); const float* Start = PartStartTimes.GetData();
+	FVector* Out = PendingLocations.GetData();
+	const float Time = Elapsed; const FVector Move = RobotMove;
+	const int32 Num = PendingLocations.Num();
+	const int32 MinParts = CVarCinematicParallelMinParts.GetValueOnAnyThread();
+	const int32 BatchSize = FMath::Max(MinParts,1);
+	ParallelFor(TEXT("ForgeFX.CinematicSample"), Num, BatchSize, [&Sampler, Home, Dir, Track, Start, Out, Time, Move](int32 i){ Out[i] = Sampler.Evaluate(Track[i], Time - Start[i], Home[i], Dir[i], Move); },
+		MinParts <=0 || Num < MinParts ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+bool UCinematicAssembleComponent::CommitCinematic()
+{
+	if (Phase == ECinematicPhase::None) return false;
+	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly) return true;
+	DropReleasedParts(*Assembly);
+	// Teleport without sweep: no physics velocity, no hit/overlap tests. Render transforms are only marked dirty here
+	// and go to the render thread together in the world's end-of-frame update.
+	for (int32 i=0; i<PartActors.Num(); ++i)
 	{
-		float A = FMath::Clamp(Elapsed / ScatterDuration,0.f,1.f);
-		for (FCinePart& P : Parts) if (P.Actor) P.Actor->SetActorLocation(FMath::Lerp(P.TargetSocketWorld.GetLocation(), P.TargetSocketWorld.GetLocation() + P.ScatterDir * ScatterDistance, A));
-		if (A >=1.f)
-		{
-			Phase = ECinematicPhase::Return; Elapsed =0.f; if (ARobotActor* Robot = Cast<ARobotActor>(GetOwner())) Robot->SetActorLocation(BaseTarget);
-		}
+		if (USceneComponent* Root = PartActors[i] ? PartActors[i]->GetRootComponent() : nullptr) Root->SetWorldLocation(PendingLocations[i], false, nullptr, ETeleportType::TeleportPhysics);
 	}
-	else if (Phase == ECinematicPhase::Return)
+	if (Phase == ECinematicPhase::Scatter && Elapsed >= FMath::Min(ActiveSampler->RobotMoveTime, TotalDuration))
 	{
-		float Araw = FMath::Clamp(Elapsed / ReturnDuration,0.f,1.f); float A = FMath::Pow(Araw, EasePower);
-		for (FCinePart& P : Parts) if (P.Actor) P.Actor->SetActorLocation(FMath::Lerp(P.TargetSocketWorld.GetLocation() + P.ScatterDir * ScatterDistance, P.TargetSocketWorld.GetLocation() + (BaseTarget - GetOwner()->GetActorLocation()), A));
-		if (Araw >=1.f)
-		{
-			for (FCinePart& P : Parts) if (P.Actor) Assembly->ReattachPart(P.Actor->GetPartName(), P.Actor);
-			Parts.Reset(); Phase = ECinematicPhase::None; Elapsed =0.f;
-		}
+		// Robot-following keys target where the robot actually lands
+		RobotMove = BaseTarget - GetOwner()->GetActorLocation();
+		Phase = ECinematicPhase::Return; if (ARobotActor* Robot = Cast<ARobotActor>(GetOwner())) Robot->SetActorLocation(BaseTarget);
+	}
+	if (Elapsed >= TotalDuration)
+	{
+		for (int32 i=0; i<PartActors.Num(); ++i) { RestoreOverlap(i); Assembly->ReattachPart(PartNames[i], PartActors[i]); }
+		ResetPartList(); ActiveSampler.Reset();
+		Phase = ECinematicPhase::None; Elapsed =0.f;
+		return false;
 	}
+	return true;
 }
@@ -1,8 +1,11 @@
 #include "Components/InteractionTraceComponent.h"
+#include "ForgeFX.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
+#include "Components/AssemblyBuilderComponent.h"
+#include "Subsystems/RobotAssemblySubsystem.h"
 
 UInteractionTraceComponent::UInteractionTraceComponent()
 {
@@ -12,52 +15,102 @@ UInteractionTraceComponent::UInteractionTraceComponent()
 void UInteractionTraceComponent::BeginPlay()
 {
 	Super::BeginPlay();
+	RefreshCachedCamera();
+}
+
+void UInteractionTraceComponent::RefreshCachedCamera()
+{
+	CachedCamera = GetOwner() ? GetOwner()->FindComponentByClass<UCameraComponent>() : nullptr;
 }
 
 void UInteractionTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	FORGEFX_SCOPE(InteractionTrace);
 
 	AActor* Owner = GetOwner();
 	if (!Owner) return;
-	UCameraComponent* Cam = Owner->FindComponentByClass<UCameraComponent>();
+	UWorld* World = GetWorld();
+
+	// Result of last frame's async trace (none if it was dropped, e.g. across a world change)
+	if (PendingTrace.IsValid())
+	{
+		FTraceDatum Datum;
+		if (World->QueryTraceData(PendingTrace, Datum))
+		{
+			const FHitResult* Blocking = Datum.OutHits.FindByPredicate([](const FHitResult& H){ return H.bBlockingHit; });
+			ApplyTraceHit(Blocking ? *Blocking : FHitResult(), PendingStart, PendingEnd);
+		}
+		PendingTrace = FTraceHandle();
+	}
+
+	UCameraComponent* Cam = CachedCamera.Get();
 	const FVector Start = Cam ? Cam->GetComponentLocation() : Owner->GetActorLocation();
 	const FVector Dir = (Cam ? Cam->GetForwardVector() : Owner->GetActorForwardVector()).GetSafeNormal();
 	const FVector End = Start + Dir * TraceDistance;
 
-	FHitResult Hit;
+	if (bThrottleWhenStill && bHasTraced && SkippedFrames < ThrottleMaxSkippedFrames
+		&& FVector::DistSquared(Start, LastTraceStart) <= FMath::Square(ThrottleMoveEpsilon)
+		&& (Dir | LastTraceDir) >= FMath::Cos(FMath::DegreesToRadians(ThrottleAngleEpsilonDeg)))
+	{
+		++SkippedFrames;
+		return;
+	}
+	SkippedFrames =0; bHasTraced = true; LastTraceStart = Start; LastTraceDir = Dir;
+
 	FCollisionQueryParams Params(SCENE_QUERY_STAT(InteractionTrace), false);
 	Params.AddIgnoredActor(Owner);
-	GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
+	if (bAsyncTrace)
+	{
+		PendingTrace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, Params);
+		PendingStart = Start; PendingEnd = End;
+		return;
+	}
+	FHitResult Hit;
+	World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
+	ApplyTraceHit(Hit, Start, End);
+}
+
+void UInteractionTraceComponent::ApplyTraceHit(const FHitResult& Hit, const FVector& Start, const FVector& End)
+{
+	AActor* HitActor = Hit.GetActor();
+	UPrimitiveComponent* NewComp = HitActor ? Hit.GetComponent() : nullptr;
+	int32 NewItem = HitActor ? Hit.Item : INDEX_NONE;
+	// Robots with a part picker have no part collision; a nearer picked part wins over the physics hit
+	if (const URobotAssemblySubsystem* Robots = URobotAssemblySubsystem::Get(GetWorld()))
+	{
+		int32 Handle = INDEX_NONE; FVector Location; float Distance;
+		if (UAssemblyBuilderComponent* Picked = Robots->PickPart(Start, End, GetOwner(), Handle, Location, Distance); Picked && (!Hit.bBlockingHit || Distance < Hit.Distance))
+		{
+			HitActor = Picked->GetOwner(); NewComp = Picked->GetPartComponentByHandle(Handle); NewItem = Picked->GetPartInstanceIndexByHandle(Handle);
+		}
+	}
 
 	// Optional debug (defaults are off in component defaults)
 	if (bDrawDebugTrace)
 	{
-		DrawDebugLine(GetWorld(), Start, End, Hit.bBlockingHit ? FColor::Green : FColor::Red, false,0.f,0,1.f);
+		DrawDebugLine(GetWorld(), Start, End, HitActor ? FColor::Green : FColor::Red, false,0.f,0,1.f);
 	}
-	if (bLogTraceHits && Hit.GetActor())
+	if (bLogTraceHits && HitActor)
 	{
-		UE_LOG(LogTemp, VeryVerbose, TEXT("Trace Hit Actor=%s Comp=%s"), *GetNameSafe(Hit.GetActor()), *GetNameSafe(Hit.GetComponent()));
+		UE_LOG(LogTemp, VeryVerbose, TEXT("Trace Hit Actor=%s Comp=%s"), *GetNameSafe(HitActor), *GetNameSafe(NewComp));
 	}
 
 	TWeakInterfacePtr<IInteractable> NewHover;
-	UPrimitiveComponent* NewComp = nullptr;
-	AActor* HitActor = Hit.GetActor();
 	if (HitActor)
 	{
-		NewComp = Hit.GetComponent();
 		if (HitActor->GetClass()->ImplementsInterface(UInteractable::StaticClass()))
 		{
 			NewHover = TWeakInterfacePtr<IInteractable>(HitActor);
 		}
 	}
-	UpdateHover(NewHover, NewComp, HitActor);
+	UpdateHover(NewHover, NewComp, HitActor, NewItem);
 }
 
-void UInteractionTraceComponent::UpdateHover(const TWeakInterfacePtr<IInteractable>& NewHover, UPrimitiveComponent* NewComp, AActor* HitActor)
+void UInteractionTraceComponent::UpdateHover(const TWeakInterfacePtr<IInteractable>& NewHover, UPrimitiveComponent* NewComp, AActor* HitActor, int32 HitItem)
 {
 	const bool bSameObj = (CurrentHover.GetObject() == NewHover.GetObject());
-	const bool bSameComp = (CurrentHitComp.Get() == NewComp);
+	const bool bSameComp = (CurrentHitComp.Get() == NewComp) && (CurrentHitItem == HitItem);
 	if (bSameObj && bSameComp) return;
 
 	if (CurrentHover.IsValid())
@@ -66,6 +119,7 @@ void UInteractionTraceComponent::UpdateHover(const TWeakInterfacePtr<IInteractab
 	}
 	CurrentHover = NewHover;
 	CurrentHitComp = NewComp;
+	CurrentHitItem = HitItem;
 	if (CurrentHover.IsValid())
 	{
 		IInteractable::Execute_OnHoverBegin(CurrentHover.GetObject());
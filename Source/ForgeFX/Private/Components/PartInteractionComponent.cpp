@@ -18,7 +18,7 @@ UAssemblyBuilderComponent* UPartInteractionComponent::GetAssembly() const
 	return nullptr;
 }
 
-bool UPartInteractionComponent::HandleInteractPressed(UPrimitiveComponent* HitComponent, AActor* HitActor, bool bAllowFreeAttach, float AttachPosTolerance, float AttachAngleToleranceDeg, float PartGrabMinDistance, float PartGrabMaxDistance)
+bool UPartInteractionComponent::HandleInteractPressed(UPrimitiveComponent* HitComponent, AActor* HitActor, bool bAllowFreeAttach, float AttachPosTolerance, float AttachAngleToleranceDeg, float PartGrabMinDistance, float PartGrabMaxDistance, int32 HitItem)
 {
 	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly) return false;
 	// Click on detached actor: attempt snap/free attach
@@ -35,7 +35,7 @@ bool UPartInteractionComponent::HandleInteractPressed(UPrimitiveComponent* HitCo
 	// Click on attached component -> detach
 	if (HitComponent)
 	{
-		FName PartName; if (Assembly->FindPartNameByComponent(HitComponent, PartName) && !Assembly->IsPartDetached(PartName))
+		FName PartName; if (Assembly->FindPartNameByHit(HitComponent, HitItem, PartName) && !Assembly->IsPartDetached(PartName))
 		{
 			ARobotPartActor* NewActor=nullptr;
 			if (Assembly->DetachPart(PartName, NewActor) && NewActor)
@@ -69,8 +69,7 @@ void UPartInteractionComponent::HandleInteractReleased(bool bHoldToDragMode, boo
 bool UPartInteractionComponent::TrySnapDragged(float AttachPosTolerance, float AttachAngleToleranceDeg)
 {
 	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly || !DraggedPartActor || DraggedPartName.IsNone()) return false;
-	USceneComponent* Parent; FName Socket; if (!Assembly->GetAttachParentAndSocket(DraggedPartName, Parent, Socket) || !Parent) return false;
-	const FTransform SocketWorld = Parent->GetSocketTransform(Socket, RTS_World);
+	FTransform SocketWorld; if (!Assembly->GetAttachSocketWorldTransform(DraggedPartName, SocketWorld)) return false;
 	const float Dist = FVector::Dist(DraggedPartActor->GetActorLocation(), SocketWorld.GetLocation()); if (Dist > AttachPosTolerance) return false;
 	const float AngleDiff = DraggedPartActor->GetActorQuat().AngularDistance(SocketWorld.GetRotation()) *180.f / PI; if (AngleDiff > AttachAngleToleranceDeg) return false;
 	Assembly->ReattachPart(DraggedPartName, DraggedPartActor); bDraggingPart = false; DraggedPartActor = nullptr; DraggedPartName = NAME_None; return true;
@@ -81,14 +80,19 @@ bool UPartInteractionComponent::TryFreeAttachDragged(bool bAllowFreeAttach, floa
 	if (!bAllowFreeAttach || !DraggedPartActor) return false;
 	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly) return false;
 	USceneComponent* Parent = nullptr; FName Socket = NAME_None; float Dist=0.f;
-	if (!Assembly->FindNearestAttachTarget(DraggedPartActor->GetActorLocation(), Parent, Socket, Dist, DraggedPartName)) return false;
-	const float MaxD = (FreeAttachMaxDistance >0.f) ? FreeAttachMaxDistance : AttachPosTolerance; if (Dist > MaxD) return false;
+	const float MaxD = (FreeAttachMaxDistance >0.f) ? FreeAttachMaxDistance : AttachPosTolerance;
+	if (!Assembly->FindNearestAttachTargetInRadius(DraggedPartActor->GetActorLocation(), MaxD, MakeArrayView(&DraggedPartName, 1), Parent, Socket, Dist)) return false;
 	Assembly->AttachDetachedPartTo(DraggedPartName, DraggedPartActor, Parent, Socket); bDraggingPart = false; DraggedPartActor = nullptr; DraggedPartName = NAME_None; return true;
 }
 
 void UPartInteractionComponent::TickPartDrag(float DeltaSeconds, float PartDragSmoothingSpeed, float InPartGrabDistance, float PartGrabMinDistance, float PartGrabMaxDistance)
 {
 	if (!bDraggingPart || !DraggedPartActor) return;
+	// Reattached from elsewhere (showcase, reattach all, cinematic) while held: the actor went back to the pool and may
+	// already be another part's, so the owning assembly's registry decides, not the actor's parked state
+	const AActor* PartOwner = DraggedPartActor->GetOwner();
+	const UAssemblyBuilderComponent* OwnerAssembly = PartOwner ? PartOwner->FindComponentByClass<UAssemblyBuilderComponent>() : nullptr;
+	if (!OwnerAssembly || OwnerAssembly->GetDetachedActor(DraggedPartName) != DraggedPartActor) { bDraggingPart = false; DraggedPartActor = nullptr; DraggedPartName = NAME_None; return; }
 	APlayerController* PC = GetWorld()->GetFirstPlayerController(); if (!PC) return;
 	int32 SizeX=0, SizeY=0; PC->GetViewportSize(SizeX, SizeY);
 	float MidX = SizeX *0.5f; float MidY = SizeY *0.5f; FVector Origin, Dir;
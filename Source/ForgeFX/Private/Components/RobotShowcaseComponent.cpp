@@ -3,13 +3,14 @@
 #include "Actors/RobotActor.h"
 #include "Actors/OrbitCameraRig.h"
 #include "Actors/RobotPartActor.h"
-#include "EngineUtils.h"
+#include "Subsystems/RobotAssemblySubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 
 URobotShowcaseComponent::URobotShowcaseComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Updated by URobotAssemblySubsystem while a showcase is running
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 UAssemblyBuilderComponent* URobotShowcaseComponent::GetAssembly() const
@@ -25,15 +26,16 @@ void URobotShowcaseComponent::StartShowcase()
 {
 	if (bActive) return;
 	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly || !Assembly->AssemblyConfig) return;
-	Order.Reset();
-	for (const FRobotPartSpec& Spec : Assembly->AssemblyConfig->Parts)
-	{
-		if (Spec.bDetachable && Spec.PartName != FName("Torso")) Order.Add(Spec.PartName);
-	}
-	if (Order.Num()==0) return;
-	Order.Sort([](const FName& A, const FName& B){ return A.LexicalLess(B); });
-	Order.Add(FName("Torso"));
-	Elapsed =0.f; Index =0; bActive = true;
+	const TArray<FName>& Order = Assembly->AssemblyConfig->GetBuildPlan().ShowcaseOrder;
+	if (Order.Num()==0 || (Order.Num()==1 && Order[0] == FName("Torso"))) return;
+	// Precompute the whole run in fixed ticks: one detach per interval, then reattach everything one interval later
+	const double Step =1.0 / FMath::Max(FixedStepHz,1);
+	auto ToTick = [Step](double Seconds){ return (int64)FMath::RoundToDouble(Seconds / Step); };
+	Schedule.Reset(Order.Num() +1);
+	for (int32 i=0; i<Order.Num(); ++i) Schedule.Add({ ToTick(InitialDelay + double(i) * DetachInterval), FShowcaseAction::EType::Detach, Order[i] });
+	Schedule.Add({ ToTick(InitialDelay + double(Order.Num()) * DetachInterval), FShowcaseAction::EType::ReattachAll, NAME_None });
+	NextAction =0; Tick =0; Accumulator =0.0; bActive = true;
+	if (URobotAssemblySubsystem* Batch = URobotAssemblySubsystem::Get(GetWorld())) Batch->AddShowcase(this);
 	// spawn camera rig
 	UWorld* W = GetWorld(); if (W)
 	{
@@ -53,7 +55,7 @@ void URobotShowcaseComponent::StartShowcase()
 void URobotShowcaseComponent::StopShowcase()
 {
 	if (!bActive) return;
-	bActive = false; Index = -1; Order.Reset();
+	bActive = false; Schedule.Reset(); NextAction =0;
 	if (APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr)
 	{
 		FViewTargetTransitionParams Blend; Blend.BlendTime =0.35f; PC->SetViewTarget(GetOwner(), Blend); PC->SetIgnoreMoveInput(false); PC->SetIgnoreLookInput(false);
@@ -61,47 +63,41 @@ void URobotShowcaseComponent::StopShowcase()
 	if (Rig.IsValid()) { Rig->Destroy(); Rig.Reset(); }
 }
 
-void URobotShowcaseComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+bool URobotShowcaseComponent::AdvanceShowcase(float DeltaTime)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	if (!bActive) return;
-	Elapsed += DeltaTime;
-	if (Elapsed < InitialDelay) return;
-	float Interval = DetachInterval; float SegmentTime = (Elapsed - InitialDelay);
-	int32 TargetIndex = FMath::FloorToInt(SegmentTime / Interval);
-	if (TargetIndex == Index && TargetIndex < Order.Num())
+	if (!bActive) return false;
+	const double Step =1.0 / FMath::Max(FixedStepHz,1);
+	Accumulator += DeltaTime;
+	const int64 Steps = (int64)FMath::FloorToDouble(Accumulator / Step);
+	Tick += Steps; Accumulator -= double(Steps) * Step;
+	// Catch up: run every overdue action in schedule order (StopShowcase from the last one clears the schedule)
+	while (bActive && NextAction < Schedule.Num() && Schedule[NextAction].Tick <= Tick) RunAction(Schedule[NextAction++]);
+	return bActive;
+}
+
+void URobotShowcaseComponent::RunAction(const FShowcaseAction& Action)
+{
+	UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly || !Assembly->AssemblyConfig) { StopShowcase(); return; }
+	if (Action.Type == FShowcaseAction::EType::Detach)
 	{
-		// detach next part once per index
-		UAssemblyBuilderComponent* Assembly = GetAssembly(); if (!Assembly) return;
-		FName Part = Order[Index];
-		if (!Assembly->IsPartDetached(Part))
+		if (Assembly->IsPartDetached(Action.Part)) return;
+		ARobotPartActor* OutActor=nullptr; if (Assembly->DetachPart(Action.Part, OutActor) && OutActor)
 		{
-			ARobotPartActor* OutActor=nullptr; if (Assembly->DetachPart(Part, OutActor) && OutActor)
-			{
-				FVector Dir = (OutActor->GetActorLocation() - GetOwner()->GetActorLocation()).GetSafeNormal(); OutActor->SetActorLocation(OutActor->GetActorLocation() + Dir *35.f);
-				if (Assembly->AssemblyConfig->DetachSound) UGameplayStatics::PlaySoundAtLocation(this, Assembly->AssemblyConfig->DetachSound, OutActor->GetActorLocation());
-				if (Assembly->AssemblyConfig->DetachEffect) UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), Assembly->AssemblyConfig->DetachEffect, OutActor->GetActorLocation());
-			}
+			FVector Dir = (OutActor->GetActorLocation() - GetOwner()->GetActorLocation()).GetSafeNormal(); OutActor->SetActorLocation(OutActor->GetActorLocation() + Dir *35.f);
+			if (Assembly->AssemblyConfig->DetachSound) UGameplayStatics::PlaySoundAtLocation(this, Assembly->AssemblyConfig->DetachSound, OutActor->GetActorLocation());
+			if (Assembly->AssemblyConfig->DetachEffect) UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), Assembly->AssemblyConfig->DetachEffect, OutActor->GetActorLocation());
 		}
-		Index++;
-		if (Index > Order.Num())
+		return;
+	}
+	// reattach pass
+	for (const FShowcaseAction& Detached : Schedule)
+	{
+		if (Detached.Type != FShowcaseAction::EType::Detach || !Assembly->IsPartDetached(Detached.Part)) continue;
+		USceneComponent* Parent; FName Socket; if (Assembly->GetAttachParentAndSocket(Detached.Part, Parent, Socket))
 		{
-			// reattach pass
-			for (int32 i=0;i<Order.Num();++i)
-			{
-				FName P = Order[i]; UAssemblyBuilderComponent* A = GetAssembly(); if (!A) break; if (A->IsPartDetached(P))
-				{
-					USceneComponent* Parent; FName Socket; if (A->GetAttachParentAndSocket(P, Parent, Socket))
-					{
-						for (TActorIterator<ARobotPartActor> It(GetWorld()); It; ++It)
-						{
-							if (It->GetPartName()==P) { A->ReattachPart(P, *It); break; }
-						}
-						if (A->AssemblyConfig->AttachSound && Parent) UGameplayStatics::PlaySoundAtLocation(this, A->AssemblyConfig->AttachSound, Parent->GetComponentLocation());
-					}
-				}
-			}
-			StopShowcase();
+			Assembly->ReattachDetachedPart(Detached.Part);
+			if (Assembly->AssemblyConfig->AttachSound && Parent) UGameplayStatics::PlaySoundAtLocation(this, Assembly->AssemblyConfig->AttachSound, Parent->GetComponentLocation());
 		}
 	}
+	StopShowcase();
 }
@@ -0,0 +1,117 @@
+#include "Data/CinematicTimeline.h"
+#include "Algo/StableSort.h"
+#include "Algo/UpperBound.h"
+
+static constexpr int32 StepEaseTable = -2; // KeyEaseTable marker: hold until the segment ends
+
+void FCinematicTimelineSampler::Compile(const TArray<FCinematicTrack>& Tracks, int32 Resolution)
+{
+	TableResolution = FMath::Clamp(Resolution, 4, 1024);
+	Duration =0.f;
+	for (int32 t=0; t<Tracks.Num(); ++t)
+	{
+		const FCinematicTrack& Track = Tracks[t];
+		TArray<int32, TInlineAllocator<16>> Sorted; for (int32 k=0; k<Track.Keys.Num(); ++k) Sorted.Add(k);
+		Algo::StableSortBy(Sorted, [&Track](int32 k){ return Track.Keys[k].Time; });
+		TrackFirstKey.Add(KeyTime.Num()); TrackNumKeys.Add(Sorted.Num()); TrackDelay.Add(FMath::Max(Track.Delay,0.f));
+		for (const int32 k : Sorted)
+		{
+			const FCinematicKey& Key = Track.Keys[k];
+			KeyTime.Add(Key.Time); KeyOffset.Add(Key.Offset); KeyScatter.Add(Key.ScatterAmount); KeyFollow.Add(Key.FollowRobot);
+			KeyEaseTable.Add(BakeEase(Key));
+		}
+		if (Sorted.Num() >0) Duration = FMath::Max(Duration, TrackDelay.Last() + KeyTime.Last());
+		if (Track.PartName.IsNone()) { if (DefaultTrack == INDEX_NONE) DefaultTrack = t; }
+		else if (!TrackByPart.Contains(Track.PartName)) TrackByPart.Add(Track.PartName, t);
+	}
+}
+
+int32 FCinematicTimelineSampler::BakeEase(const FCinematicKey& Key)
+{
+	if (Key.Ease == ECinematicEase::Linear) return INDEX_NONE;
+	if (Key.Ease == ECinematicEase::Step) return StepEaseTable;
+	const FRichCurve* Curve = Key.Ease == ECinematicEase::Curve ? Key.EaseCurve.GetRichCurveConst() : nullptr;
+	if (Key.Ease == ECinematicEase::Curve && (!Curve || Curve->GetNumKeys() ==0)) return INDEX_NONE;
+	const float Exp = FMath::Max(Key.EaseExponent, KINDA_SMALL_NUMBER);
+	const int32 First = EaseTables.AddUninitialized(TableResolution +1);
+	for (int32 i=0; i<=TableResolution; ++i)
+	{
+		const float A = float(i) / TableResolution; float V = A;
+		switch (Key.Ease)
+		{
+			case ECinematicEase::EaseIn: V = FMath::Pow(A, Exp); break;
+			case ECinematicEase::EaseOut: V =1.f - FMath::Pow(1.f - A, Exp); break;
+			case ECinematicEase::EaseInOut: V = FMath::InterpEaseInOut(0.f,1.f, A, Exp); break;
+			case ECinematicEase::Curve: V = Curve->Eval(A); break;
+			default: break;
+		}
+		EaseTables[First + i] = V;
+	}
+	return First;
+}
+
+float FCinematicTimelineSampler::SampleEase(int32 Table, float Alpha) const
+{
+	if (Table == INDEX_NONE) return Alpha;
+	if (Table == StepEaseTable) return Alpha >=1.f ?1.f :0.f;
+	const float X = Alpha * TableResolution; const int32 i = FMath::Min(FMath::FloorToInt32(X), TableResolution -1);
+	return FMath::Lerp(EaseTables[Table + i], EaseTables[Table + i +1], X - i);
+}
+
+int32 FCinematicTimelineSampler::FindTrack(FName PartName) const
+{
+	const int32* Found = TrackByPart.Find(PartName);
+	return Found ? *Found : DefaultTrack;
+}
+
+FVector FCinematicTimelineSampler::Evaluate(int32 Track, float Time, const FVector& Home, const FVector& ScatterDir, const FVector& RobotMove) const
+{
+	if (!TrackNumKeys.IsValidIndex(Track) || TrackNumKeys[Track] ==0) return Home;
+	const int32 First = TrackFirstKey[Track], Num = TrackNumKeys[Track];
+	auto Pose = [&](int32 k){ return Home + KeyOffset[k] + ScatterDir * KeyScatter[k] + RobotMove * KeyFollow[k]; };
+	const float T = Time - TrackDelay[Track];
+	// Index of the first key after T within this track's slice
+	const int32 Next = First + Algo::UpperBound(TConstArrayView<float>(KeyTime.GetData() + First, Num), T);
+	if (Next == First) return Pose(First);
+	if (Next == First + Num) return Pose(First + Num -1);
+	const float Span = KeyTime[Next] - KeyTime[Next -1];
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? (T - KeyTime[Next -1]) / Span :1.f;
+	return FMath::Lerp(Pose(Next -1), Pose(Next), SampleEase(KeyEaseTable[Next], Alpha));
+}
+
+FCinematicTimelineSampler FCinematicTimelineSampler::MakeScatterReturn(float ScatterDuration, float ReturnDuration, float ScatterDistance, float EasePower)
+{
+	FCinematicTrack Track;
+	Track.Keys.AddDefaulted(); // rest pose at the socket
+	FCinematicKey& Out = Track.Keys.AddDefaulted_GetRef(); Out.Time = ScatterDuration; Out.ScatterAmount = ScatterDistance;
+	FCinematicKey& Back = Track.Keys.AddDefaulted_GetRef(); Back.Time = ScatterDuration + ReturnDuration; Back.FollowRobot =1.f; Back.Ease = ECinematicEase::EaseIn; Back.EaseExponent = EasePower;
+	FCinematicTimelineSampler Sampler; Sampler.Compile({ Track }, 64);
+	Sampler.RobotMoveTime = ScatterDuration;
+	return Sampler;
+}
+
+TSharedRef<const FCinematicTimelineSampler> UCinematicTimeline::GetSampler() const
+{
+	if (!Sampler.IsValid())
+	{
+		TSharedRef<FCinematicTimelineSampler> Compiled = MakeShared<FCinematicTimelineSampler>();
+		Compiled->Compile(Tracks, CurveTableResolution);
+		Compiled->StaggerPerPart = FMath::Max(StaggerPerPart,0.f); Compiled->RobotMoveTime = RobotMoveTime;
+		Sampler = Compiled;
+	}
+	return Sampler.ToSharedRef();
+}
+
+void UCinematicTimeline::PostLoad()
+{
+	Super::PostLoad();
+	InvalidateSampler();
+}
+
+#if WITH_EDITOR
+void UCinematicTimeline::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateSampler();
+}
+#endif
@@ -0,0 +1,119 @@
+#include "Data/RobotAssemblyConfig.h"
+
+void URobotAssemblyConfig::RebuildPartIndex()
+{
+	RefreshPartIndex();
+	InvalidateBuildPlan();
+}
+
+static uint32 HashPartNames(const TArray<FRobotPartSpec>& Parts)
+{
+	uint32 Hash = 0;
+	for (const FRobotPartSpec& Spec : Parts) Hash = HashCombineFast(Hash, GetTypeHash(Spec.PartName));
+	return Hash;
+}
+
+void URobotAssemblyConfig::RefreshPartIndex() const
+{
+	PartIndexByName.Reset();
+	PartIndexByName.Reserve(Parts.Num());
+	for (int32 i=0; i<Parts.Num(); ++i)
+	{
+		if (!PartIndexByName.Contains(Parts[i].PartName)) PartIndexByName.Add(Parts[i].PartName, i);
+	}
+	IndexedPartCount = Parts.Num();
+	IndexedNameHash = HashPartNames(Parts);
+	KnownMisses.Reset();
+}
+
+int32 URobotAssemblyConfig::FindPartIndex(FName PartName) const
+{
+	// Parts appended/removed from code without RebuildPartIndex are caught by the count check
+	if (IndexedPartCount != Parts.Num()) RefreshPartIndex();
+	const int32* Found = PartIndexByName.Find(PartName);
+	if (Found && Parts.IsValidIndex(*Found) && Parts[*Found].PartName == PartName) return *Found;
+	// Names of other configs' parts (e.g. dragging a foreign robot's part) miss every frame: answered from the set
+	if (!Found && KnownMisses.Contains(PartName)) return INDEX_NONE;
+	// Stale slot, or a first miss: re-index only if the name column changed in place (renamed/reordered from code).
+	// The build plan is left alone; it checks its own snapshot in GetBuildPlan.
+	if (Found || HashPartNames(Parts) != IndexedNameHash)
+	{
+		RefreshPartIndex();
+		Found = PartIndexByName.Find(PartName);
+	}
+	if (!Found) { KnownMisses.Add(PartName); return INDEX_NONE; }
+	return *Found;
+}
+
+const FRobotPartSpec* URobotAssemblyConfig::FindPartSpec(FName PartName) const
+{
+	const int32 Index = FindPartIndex(PartName);
+	return Index != INDEX_NONE ? &Parts[Index] : nullptr;
+}
+
+FRobotAssemblyBuildPlan& URobotAssemblyConfig::GetBuildPlan() const
+{
+	// Snapshot check (count, names, parents, detachable, mesh paths) guards against edits from code that skipped RebuildPartIndex
+	if (BuildPlan.IsValid() && BuildPlan->Matches(Parts)) return *BuildPlan;
+	const_cast<URobotAssemblyConfig*>(this)->RebuildPartIndex();
+	BuildPlan = MakeUnique<FRobotAssemblyBuildPlan>();
+	FRobotAssemblyBuildPlan& Plan = *BuildPlan;
+	const int32 Num = Parts.Num();
+	Plan.ParentSpecIndex.Init(INDEX_NONE, Num);
+	Plan.Meshes.SetNum(Num);
+	Plan.Names.Reserve(Num); Plan.ParentNames.Reserve(Num); Plan.MeshPaths.Reserve(Num);
+	for (const FRobotPartSpec& Spec : Parts) { Plan.Names.Add(Spec.PartName); Plan.ParentNames.Add(Spec.ParentPartName); Plan.Detachable.Add(Spec.bDetachable); Plan.MeshPaths.Add(Spec.Mesh.ToSoftObjectPath()); }
+	Plan.Order.Reserve(Num);
+	TArray<TArray<int32, TInlineAllocator<4>>> Children; Children.SetNum(Num);
+	TArray<int32> Roots;
+	for (int32 i=0; i<Num; ++i)
+	{
+		const int32* Parent = Parts[i].ParentPartName.IsNone() ? nullptr : PartIndexByName.Find(Parts[i].ParentPartName);
+		if (Parent && *Parent != i) { Plan.ParentSpecIndex[i] = *Parent; Children[*Parent].Add(i); }
+		else Roots.Add(i);
+	}
+	// Breadth-first from the roots keeps config order among siblings
+	for (const int32 Root : Roots) Plan.Order.Add(Root);
+	for (int32 Cursor=0; Cursor<Plan.Order.Num(); ++Cursor) Plan.Order.Append(Children[Plan.Order[Cursor]]);
+	if (Plan.Order.Num() < Num)
+	{
+		// Anything unreached sits on a parent cycle: attach to the root in config order
+		TBitArray<> Reached(false, Num); for (const int32 i : Plan.Order) Reached[i] = true;
+		for (int32 i=0; i<Num; ++i) if (!Reached[i]) { Plan.ParentSpecIndex[i] = INDEX_NONE; Plan.Order.Add(i); }
+	}
+	// Showcase detach order is stable across machines: lexical (not FName index) compare
+	for (const FRobotPartSpec& Spec : Parts) if (Spec.bDetachable && Spec.PartName != FName("Torso")) Plan.ShowcaseOrder.AddUnique(Spec.PartName);
+	Plan.ShowcaseOrder.Sort([](const FName& A, const FName& B){ return A.LexicalLess(B); });
+	if (PartIndexByName.Contains(FName("Torso"))) Plan.ShowcaseOrder.Add(FName("Torso"));
+	return Plan;
+}
+
+bool FRobotAssemblyBuildPlan::Matches(const TArray<FRobotPartSpec>& Parts) const
+{
+	if (Names.Num() != Parts.Num()) return false;
+	for (int32 i=0; i<Parts.Num(); ++i) if (Names[i] != Parts[i].PartName || ParentNames[i] != Parts[i].ParentPartName || Detachable[i] != Parts[i].bDetachable
+		|| MeshPaths[i] != Parts[i].Mesh.ToSoftObjectPath()) return false;
+	return true;
+}
+
+UStaticMesh* FRobotAssemblyBuildPlan::ResolveMesh(const FRobotPartSpec& Spec, int32 SpecIndex, bool bAllowLoad)
+{
+	if (UStaticMesh* Cached = Meshes[SpecIndex].Get()) return Cached;
+	UStaticMesh* Mesh = bAllowLoad ? Spec.Mesh.LoadSynchronous() : Spec.Mesh.Get();
+	Meshes[SpecIndex] = Mesh;
+	return Mesh;
+}
+
+void URobotAssemblyConfig::PostLoad()
+{
+	Super::PostLoad();
+	RebuildPartIndex();
+}
+
+#if WITH_EDITOR
+void URobotAssemblyConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RebuildPartIndex();
+}
+#endif
@@ -0,0 +1,116 @@
+#include "Data/RobotAssemblyGenerator.h"
+#include "Data/RobotAssemblyConfig.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "UObject/Package.h"
+
+static const TCHAR* GetShapePath(ERobotGenShape Shape)
+{
+	switch (Shape)
+	{
+		case ERobotGenShape::Sphere: return TEXT("/Engine/BasicShapes/Sphere.Sphere");
+		case ERobotGenShape::Cylinder: return TEXT("/Engine/BasicShapes/Cylinder.Cylinder");
+		case ERobotGenShape::Cone: return TEXT("/Engine/BasicShapes/Cone.Cone");
+		default: return TEXT("/Engine/BasicShapes/Cube.Cube");
+	}
+}
+
+FName URobotAssemblyGenerator::GetSocketName(int32 SocketIndex)
+{
+	return FName(*FString::Printf(TEXT("S_Gen%d"), SocketIndex));
+}
+
+FTransform URobotAssemblyGenerator::GetSocketLocal(const UStaticMesh* Mesh, int32 SocketIndex, int32 NumSockets)
+{
+	// Fibonacci sphere direction, pushed out to the bounds box; X faces away from the part
+	const float Z =1.f -2.f * (SocketIndex +0.5f) / FMath::Max(NumSockets, 1);
+	const float R = FMath::Sqrt(FMath::Max(1.f - Z * Z, 0.f)), Phi = SocketIndex * PI * (3.f - FMath::Sqrt(5.f));
+	const FVector Dir(FMath::Cos(Phi) * R, FMath::Sin(Phi) * R, Z);
+	const FBoxSphereBounds Bounds = Mesh ? Mesh->GetBounds() : FBoxSphereBounds(FVector::ZeroVector, FVector(50.f), 50.f);
+	const FVector Extent = Bounds.BoxExtent.ComponentMax(FVector(KINDA_SMALL_NUMBER));
+	const double Scale =1.0 / FMath::Max3(FMath::Abs(Dir.X) / Extent.X, FMath::Abs(Dir.Y) / Extent.Y, FMath::Abs(Dir.Z) / Extent.Z);
+	return FTransform(FRotationMatrix::MakeFromX(Dir).ToQuat(), Bounds.Origin + Dir * Scale);
+}
+
+UStaticMesh* URobotAssemblyGenerator::GetShapeMesh(ERobotGenShape Shape, int32 NumSockets)
+{
+	UStaticMesh* Base = LoadObject<UStaticMesh>(nullptr, GetShapePath(Shape));
+	if (!Base || NumSockets <=0) return Base;
+#if WITH_EDITOR
+	const FString Name = FString::Printf(TEXT("%s_Gen%dSockets"), *Base->GetName(), NumSockets);
+	if (UStaticMesh* Existing = FindObject<UStaticMesh>(GetTransientPackage(), *Name)) return Existing;
+	UStaticMesh* Mesh = DuplicateObject<UStaticMesh>(Base, GetTransientPackage(), FName(*Name));
+	for (int32 i=0; i<NumSockets; ++i)
+	{
+		const FTransform Local = GetSocketLocal(Base, i, NumSockets);
+		UStaticMeshSocket* Socket = NewObject<UStaticMeshSocket>(Mesh);
+		Socket->SocketName = GetSocketName(i); Socket->RelativeLocation = Local.GetLocation(); Socket->RelativeRotation = Local.Rotator();
+		Mesh->AddSocket(Socket);
+	}
+	Mesh->Build(true);
+	Mesh->AddToRoot(); // generated configs only hold soft references
+	return Mesh;
+#else
+	return Base; // no mesh building in cooked builds; the caller falls back to socketless placement
+#endif
+}
+
+URobotAssemblyConfig* URobotAssemblyGenerator::GenerateAssemblyConfig(const FRobotAssemblyGenSettings& Settings, UObject* Outer)
+{
+	FRandomStream Rng(Settings.Seed);
+	URobotAssemblyConfig* Config = NewObject<URobotAssemblyConfig>(Outer ? Outer : GetTransientPackage());
+	const int32 NumParts = FMath::Max(Settings.NumParts, 1), MaxDepth = FMath::Max(Settings.MaxDepth, 1);
+	const int32 NumSockets = FMath::Clamp(Settings.SocketsPerPart, 0, 32);
+	const int32 Branching = NumSockets >0 ? FMath::Clamp(Settings.BranchingFactor, 1, NumSockets) : FMath::Max(Settings.BranchingFactor, 1);
+	const int32 NumSlots = NumSockets >0 ? NumSockets : Branching;
+
+	TArray<ERobotGenShape, TInlineAllocator<4>> Shapes(Settings.Shapes); if (Shapes.Num() ==0) Shapes.Add(ERobotGenShape::Cube);
+	TArray<UStaticMesh*, TInlineAllocator<4>> Meshes; TBitArray<> HasSockets;
+	for (const ERobotGenShape Shape : Shapes)
+	{
+		UStaticMesh* Mesh = GetShapeMesh(Shape, NumSockets);
+		Meshes.Add(Mesh); HasSockets.Add(Mesh && NumSockets >0 && Mesh->FindSocket(GetSocketName(0)) != nullptr);
+	}
+
+	// Breadth-first, every part takes Branching children until NumParts is reached or MaxDepth is hit
+	TArray<int32> PartShape, PartDepth;
+	auto AddPart = [&](FName ParentName, int32 Depth) -> FRobotPartSpec&
+	{
+		const int32 Index = Config->Parts.Num();
+		const int32 Shape = Rng.RandRange(0, Meshes.Num() -1);
+		PartShape.Add(Shape); PartDepth.Add(Depth);
+		FRobotPartSpec& Spec = Config->Parts.AddDefaulted_GetRef();
+		Spec.PartName = Index ==0 ? FName(TEXT("Torso")) : FName(*FString::Printf(TEXT("Part%d"), Index));
+		Spec.ParentPartName = ParentName;
+		Spec.Mesh = Meshes[Shape];
+		return Spec;
+	};
+	FRobotPartSpec& Root = AddPart(NAME_None, 0);
+	Root.bDetachable = false; Root.RelativeTransform = FTransform(FQuat::Identity, FVector::ZeroVector, FVector(FMath::Max(Settings.PartScale, 0.01f)));
+
+	TArray<int32, TInlineAllocator<32>> Slots;
+	for (int32 Cursor=0; Cursor<Config->Parts.Num() && Config->Parts.Num()<NumParts; ++Cursor)
+	{
+		if (PartDepth[Cursor] >= MaxDepth) continue;
+		const FName ParentName = Config->Parts[Cursor].PartName; const int32 ParentShape = PartShape[Cursor], ChildDepth = PartDepth[Cursor] +1;
+		Slots.Reset(); for (int32 s=0; s<NumSlots; ++s) Slots.Add(s);
+		for (int32 s=NumSlots -1; s>0; --s) Slots.Swap(s, Rng.RandRange(0, s));
+		for (int32 c=0; c<Branching && Config->Parts.Num()<NumParts; ++c)
+		{
+			FRobotPartSpec& Spec = AddPart(ParentName, ChildDepth);
+			const UStaticMesh* ChildMesh = Meshes[PartShape.Last()];
+			const float ChildExtent = ChildMesh ? ChildMesh->GetBounds().BoxExtent.X :50.f;
+			// Child sits just outside its socket, rolled about the socket's outward axis
+			const FTransform ChildLocal(FRotator(0.f,0.f, Rng.FRandRange(-180.f,180.f)).Quaternion(), FVector(ChildExtent,0.f,0.f));
+			if (HasSockets[ParentShape]) { Spec.ParentSocketName = GetSocketName(Slots[c]); Spec.RelativeTransform = ChildLocal; }
+			else Spec.RelativeTransform = ChildLocal * GetSocketLocal(Meshes[ParentShape], Slots[c], NumSlots);
+			Spec.bDetachable = Rng.FRand() < Settings.DetachableRatio;
+		}
+	}
+	if (Config->Parts.Num() < NumParts)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GenerateAssemblyConfig: %d of %d parts fit in depth %d x branching %d"), Config->Parts.Num(), NumParts, MaxDepth, Branching);
+	}
+	Config->RebuildPartIndex();
+	return Config;
+}
@@ -0,0 +1,64 @@
+#include "Subsystems/RobotAssemblySubsystem.h"
+#include "ForgeFX.h"
+#include "Components/AssemblyBuilderComponent.h"
+#include "Components/CinematicAssembleComponent.h"
+#include "Components/RobotShowcaseComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarBatchParallel(TEXT("ForgeFX.Batch.Parallel"), 1, TEXT("Run the robot batch math phase across worker threads (0 = game thread only)."));
+static TAutoConsoleVariable<int32> CVarBatchParallelMin(TEXT("ForgeFX.Batch.ParallelMinItems"), 8, TEXT("Minimum active robots in a list before its math phase goes wide."));
+
+template <typename T>
+static void RemoveInvalid(TArray<TObjectPtr<T>>& List)
+{
+	for (int32 i=List.Num()-1; i>=0; --i) if (!IsValid(List[i])) List.RemoveAtSwap(i, 1, EAllowShrinking::No);
+}
+
+void URobotAssemblySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	RemoveInvalid(Highlights); RemoveInvalid(Cinematics); RemoveInvalid(Showcases);
+	const bool bAllowParallel = CVarBatchParallel.GetValueOnGameThread() !=0;
+	const int32 MinItems = CVarBatchParallelMin.GetValueOnGameThread();
+
+	// Math phase: each item only touches its own POD state
+	{
+		FORGEFX_SCOPE(HighlightTick);
+		ParallelFor(Highlights.Num(), [this, DeltaTime](int32 i){ Highlights[i]->StepHighlight(DeltaTime); }, !bAllowParallel || Highlights.Num() < MinItems);
+	}
+	{
+		FORGEFX_SCOPE(CinematicTick);
+		ParallelFor(Cinematics.Num(), [this, DeltaTime](int32 i){ Cinematics[i]->StepCinematic(DeltaTime); }, !bAllowParallel || Cinematics.Num() < MinItems);
+	}
+
+	// Commit phase (game thread): push results to materials/actors and drop whatever went idle.
+	// Commits may enqueue new work; appended items are picked up next frame.
+	{
+		FORGEFX_SCOPE(HighlightTick);
+		for (int32 i=Highlights.Num()-1; i>=0; --i) if (!Highlights[i]->CommitHighlight()) Highlights.RemoveAtSwap(i, 1, EAllowShrinking::No);
+	}
+	{
+		FORGEFX_SCOPE(CinematicTick);
+		for (int32 i=Cinematics.Num()-1; i>=0; --i) if (!Cinematics[i]->CommitCinematic()) Cinematics.RemoveAtSwap(i, 1, EAllowShrinking::No);
+	}
+	{
+		FORGEFX_SCOPE(ShowcaseTick);
+		for (int32 i=Showcases.Num()-1; i>=0; --i) if (!Showcases[i]->AdvanceShowcase(DeltaTime)) Showcases.RemoveAtSwap(i, 1, EAllowShrinking::No);
+	}
+}
+
+UAssemblyBuilderComponent* URobotAssemblySubsystem::PickPart(const FVector& Start, const FVector& End, const AActor* IgnoreActor, int32& OutHandle, FVector& OutLocation, float& OutDistance) const
+{
+	UAssemblyBuilderComponent* Best = nullptr; OutDistance = TNumericLimits<float>::Max();
+	for (const TWeakObjectPtr<UAssemblyBuilderComponent>& Weak : Pickers)
+	{
+		UAssemblyBuilderComponent* Assembly = Weak.Get(); if (!Assembly || Assembly->GetOwner() == IgnoreActor) continue;
+		int32 Handle; FVector Location; float Distance;
+		if (Assembly->PickPart(Start, End, Handle, Location, Distance) && Distance < OutDistance)
+		{
+			Best = Assembly; OutHandle = Handle; OutLocation = Location; OutDistance = Distance;
+		}
+	}
+	return Best;
+}
@@ -0,0 +1,67 @@
+#include "Subsystems/RobotPartActorPool.h"
+#include "Actors/RobotPartActor.h"
+#include "Engine/World.h"
+
+ARobotPartActor* URobotPartActorPool::Acquire(TSubclassOf<ARobotPartActor> Class, const FTransform& Transform)
+{
+	if (!Class) Class = ARobotPartActor::StaticClass();
+	if (FRobotPartActorPoolBucket* Bucket = Buckets.Find(Class))
+	{
+		while (Bucket->Idle.Num() >0)
+		{
+			ARobotPartActor* Actor = Bucket->Idle.Pop(EAllowShrinking::No); --Stats.Idle;
+			if (!IsValid(Actor)) continue; // destroyed behind our back (e.g. level teardown)
+			Actor->ActivateFromPool(Transform);
+			++Stats.Hits;
+			return Actor;
+		}
+	}
+	++Stats.Misses;
+	UWorld* World = GetWorld(); if (!World) return nullptr;
+	return World->SpawnActor<ARobotPartActor>(Class, Transform);
+}
+
+void URobotPartActorPool::Release(ARobotPartActor* Actor)
+{
+	if (!IsValid(Actor) || Actor->IsParked()) return; // already idle; parking twice would hand one actor out twice
+	Actor->DeactivateToPool();
+	Buckets.FindOrAdd(Actor->GetClass()).Idle.Add(Actor);
+	++Stats.Released; ++Stats.Idle;
+}
+
+ARobotPartActor* URobotPartActorPool::SpawnParked(TSubclassOf<ARobotPartActor> Class, const FTransform& Transform)
+{
+	UWorld* World = GetWorld(); if (!World) return nullptr;
+	ARobotPartActor* Actor = World->SpawnActor<ARobotPartActor>(Class, Transform);
+	if (Actor) Actor->DeactivateToPool();
+	return Actor;
+}
+
+void URobotPartActorPool::Prewarm(TSubclassOf<ARobotPartActor> Class, int32 Count)
+{
+	if (!Class) Class = ARobotPartActor::StaticClass();
+	FRobotPartActorPoolBucket& Bucket = Buckets.FindOrAdd(Class);
+	while (Bucket.Idle.Num() < Count)
+	{
+		ARobotPartActor* Actor = SpawnParked(Class, FTransform::Identity); if (!Actor) break;
+		Bucket.Idle.Add(Actor); ++Stats.Prewarmed; ++Stats.Idle;
+	}
+}
+
+void URobotPartActorPool::Drain()
+{
+	for (auto& Pair : Buckets) for (ARobotPartActor* Actor : Pair.Value.Idle) if (IsValid(Actor)) Actor->Destroy();
+	Buckets.Reset(); Stats.Idle =0;
+}
+
+void URobotPartActorPool::DumpStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("PartActorPool: Hits=%d Misses=%d Released=%d Prewarmed=%d Idle=%d Classes=%d"), Stats.Hits, Stats.Misses, Stats.Released, Stats.Prewarmed, Stats.Idle, Buckets.Num());
+}
+
+void URobotPartActorPool::Deinitialize()
+{
+	// The world destroys the actors themselves; just drop our references
+	Buckets.Reset(); Stats.Idle =0;
+	Super::Deinitialize();
+}
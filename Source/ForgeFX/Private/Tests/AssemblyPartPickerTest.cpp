@@ -0,0 +1,37 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Components/AssemblyPartPicker.h"
+#include "Engine/StaticMesh.h"
+
+// Ray picking without physics: nearest part wins, filtered parts and misses are ignored (no world needed).
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssemblyPartPickerTest, "ForgeFX.Robot.Assembly.PartPicker", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssemblyPartPickerTest::RunTest(const FString& Parameters)
+{
+	const UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")); // 100cm, centred
+	if (!TestNotNull(TEXT("Engine cube"), Cube)) return false;
+
+	FAssemblyPartPicker Picker;
+	Picker.AddPart(0, Cube); Picker.AddPart(1, Cube); Picker.AddPart(2, nullptr);
+	const FTransform World[] = { FTransform(FVector(500,0,0)), FTransform(FRotator(0,45,0), FVector(300,0,0), FVector(0.5f)), FTransform::Identity };
+	Picker.Refresh([&World](int32 Part){ return World[Part]; });
+	auto All = [](int32){ return true; };
+
+	FVector Location; float Distance =0.f;
+	TestEqual(TEXT("Nearest part along the ray"), Picker.Raycast(FVector::ZeroVector, FVector(1000,0,0), All, Location, Distance), 1);
+	// Rotated half-size cube: nearest face corner sits at 300 - 25 * sqrt(2)
+	TestTrue(TEXT("Hit on the rotated box"), FMath::IsNearlyEqual(Distance, 300.f - 25.f * UE_SQRT_2, 1.f));
+	TestEqual(TEXT("Filtered part is skipped"), Picker.Raycast(FVector::ZeroVector, FVector(1000,0,0), [](int32 Part){ return Part !=1; }, Location, Distance), 0);
+	TestTrue(TEXT("Face of the far cube"), Location.Equals(FVector(450,0,0), 0.1f));
+	TestEqual(TEXT("Segment ends before the parts"), Picker.Raycast(FVector::ZeroVector, FVector(200,0,0), All, Location, Distance), (int32)INDEX_NONE);
+	TestEqual(TEXT("Ray passes beside"), Picker.Raycast(FVector(0,200,0), FVector(1000,200,0), All, Location, Distance), (int32)INDEX_NONE);
+
+	// Moving a part only takes effect after it is marked dirty
+	Picker.MarkPartDirty(0);
+	Picker.Refresh([](int32){ return FTransform(FVector(500,400,0)); });
+	TestEqual(TEXT("Moved part hit at its new place"), Picker.Raycast(FVector(0,400,0), FVector(1000,400,0), All, Location, Distance), 0);
+	TestTrue(TEXT("Combined bounds follow the moved part"), Picker.GetWorldBounds().IsInsideOrOn(FVector(500,400,0)));
+	TestEqual(TEXT("Ray outside the combined bounds"), Picker.Raycast(FVector(0,0,1000), FVector(1000,0,1000), All, Location, Distance), (int32)INDEX_NONE);
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
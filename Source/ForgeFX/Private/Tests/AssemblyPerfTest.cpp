@@ -0,0 +1,163 @@
+// Perf benchmarks for assembly operations (PerfFilter; not part of the regular correctness run).
+// Headless: UnrealEditor-Cmd <Project>.uproject -ExecCmds="Automation RunTests ForgeFX.Perf; Quit" -nullrhi -unattended
+// Overrides: -ForgeFXPerfRobots=N -ForgeFXPerfParts=N -ForgeFXPerfSeed=N -ForgeFXPerfOut=<dir>
+// Writes <out>/<Preset>.json per run and appends one row per operation to <out>/ForgeFXPerf.csv.
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Actors/RobotActor.h"
+#include "Actors/RobotPartActor.h"
+#include "Components/AssemblyBuilderComponent.h"
+#include "Data/RobotAssemblyConfig.h"
+#include "Data/RobotAssemblyGenerator.h"
+#include "Subsystems/RobotAssemblySubsystem.h"
+
+namespace ForgeFXPerf
+{
+	struct FSeries
+	{
+		FString Name;
+		TArray<double> Ms;
+		template <typename FuncType> void Time(FuncType&& Func)
+		{
+			const uint64 Start = FPlatformTime::Cycles64(); Func();
+			Ms.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start));
+		}
+	};
+
+	struct FSummary { int32 Samples =0; double Mean =0, P50 =0, P90 =0, P99 =0, Max =0; };
+
+	// Nearest-rank percentiles over the sorted samples
+	static FSummary Summarize(TArray<double> Ms)
+	{
+		FSummary S; S.Samples = Ms.Num(); if (Ms.Num() ==0) return S;
+		Ms.Sort();
+		auto Rank = [&Ms](double P){ return Ms[FMath::Clamp(FMath::CeilToInt32(P * Ms.Num()) -1, 0, Ms.Num() -1)]; };
+		for (const double V : Ms) S.Mean += V;
+		S.Mean /= Ms.Num(); S.P50 = Rank(0.5); S.P90 = Rank(0.9); S.P99 = Rank(0.99); S.Max = Ms.Last();
+		return S;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAssemblyPerfTest, "ForgeFX.Perf.Assembly", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FAssemblyPerfTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	// Name, robots, parts per robot
+	OutBeautifiedNames.Add(TEXT("Small")); OutTestCommands.Add(TEXT("Small 4 16"));
+	OutBeautifiedNames.Add(TEXT("Medium")); OutTestCommands.Add(TEXT("Medium 16 32"));
+	OutBeautifiedNames.Add(TEXT("Large")); OutTestCommands.Add(TEXT("Large 64 64"));
+}
+
+bool FAssemblyPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace ForgeFXPerf;
+	TArray<FString> Args; Parameters.ParseIntoArrayWS(Args);
+	const FString Preset = Args.IsValidIndex(0) ? Args[0] : TEXT("Custom");
+	int32 NumRobots = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) :4;
+	int32 NumParts = Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) :16;
+	int32 Seed =1337;
+	FParse::Value(FCommandLine::Get(), TEXT("ForgeFXPerfRobots="), NumRobots);
+	FParse::Value(FCommandLine::Get(), TEXT("ForgeFXPerfParts="), NumParts);
+	FParse::Value(FCommandLine::Get(), TEXT("ForgeFXPerfSeed="), Seed);
+	FString OutDir = FPaths::ProjectSavedDir() / TEXT("Automation/ForgeFXPerf");
+	FParse::Value(FCommandLine::Get(), TEXT("ForgeFXPerfOut="), OutDir);
+	NumRobots = FMath::Max(NumRobots, 1); NumParts = FMath::Max(NumParts, 2);
+
+	UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+	if (!TestNotNull(TEXT("World"), World)) return false;
+	FRobotAssemblyGenSettings Gen; Gen.Seed = Seed; Gen.NumParts = NumParts;
+	URobotAssemblyConfig* Config = URobotAssemblyGenerator::GenerateAssemblyConfig(Gen);
+	TArray<FName> Detachable; for (const FRobotPartSpec& Spec : Config->Parts) if (Spec.bDetachable) Detachable.Add(Spec.PartName);
+
+	TArray<ARobotActor*> Robots; TArray<UAssemblyBuilderComponent*> Assemblies;
+	for (int32 r=0; r<NumRobots; ++r)
+	{
+		FActorSpawnParameters Params; Params.ObjectFlags = RF_Transient;
+		ARobotActor* Robot = World->SpawnActor<ARobotActor>(FVector((r %8) *500.f, (r /8) *500.f, 0.f), FRotator::ZeroRotator, Params);
+		UAssemblyBuilderComponent* Assembly = Robot ? Robot->FindComponentByClass<UAssemblyBuilderComponent>() : nullptr;
+		if (!TestNotNull(TEXT("Robot assembly"), Assembly)) return false;
+		Assembly->AssemblyConfig = Config; Assembly->bAsyncMeshLoading = false;
+		Robots.Add(Robot); Assemblies.Add(Assembly);
+	}
+	Assemblies[0]->BuildAssembly(); // warm-up: plan and mesh resolve are shared per config, not per build
+
+	FSeries Build{ TEXT("BuildAssembly") }, Scramble{ TEXT("Scramble") }, DetachAll{ TEXT("DetachAll") }, ReattachAll{ TEXT("ReattachAll") };
+	FSeries Nearest{ TEXT("FindNearestAttachTarget") }, HighlightFrame{ TEXT("HighlightFrame") };
+
+	for (UAssemblyBuilderComponent* Assembly : Assemblies) Build.Time([Assembly]{ Assembly->BuildAssembly(); });
+
+	for (int32 r=0; r<NumRobots; ++r)
+	{
+		Scramble.Time([Robot = Robots[r]]{ Robot->ScrambleParts(); });
+		Assemblies[r]->BuildAssembly(); // back to the home layout
+	}
+
+	int32 NumDetached =0, NumReattached =0;
+	TArray<ARobotPartActor*> PartActors;
+	for (UAssemblyBuilderComponent* Assembly : Assemblies)
+	{
+		PartActors.Reset();
+		DetachAll.Time([&]{ for (const FName Name : Detachable) { ARobotPartActor* Actor = nullptr; if (Assembly->DetachPart(Name, Actor)) { PartActors.Add(Actor); ++NumDetached; } } });
+		ReattachAll.Time([&]{ for (ARobotPartActor* Actor : PartActors) if (Assembly->ReattachPart(Actor->GetPartName(), Actor)) ++NumReattached; });
+	}
+	TestEqual(TEXT("Every detachable part detached"), NumDetached, Detachable.Num() * NumRobots);
+	TestEqual(TEXT("Every detached part reattached"), NumReattached, NumDetached);
+
+	FRandomStream Rng(Seed);
+	for (int32 r=0; r<NumRobots; ++r)
+	{
+		const FVector Center = Robots[r]->GetActorLocation();
+		for (int32 q=0; q<256; ++q)
+		{
+			const FVector At = Center + Rng.GetUnitVector() * Rng.FRandRange(0.f, 200.f);
+			USceneComponent* Parent = nullptr; FName Socket; float Dist =0.f;
+			Nearest.Time([&]{ Assemblies[r]->FindNearestAttachTargetInRadius(At, 50.f, {}, Parent, Socket, Dist); });
+		}
+	}
+
+	// Highlight toggles every 60 frames so the batch keeps converging parts in flight
+	URobotAssemblySubsystem* Batch = URobotAssemblySubsystem::Get(World);
+	if (TestNotNull(TEXT("Assembly subsystem"), Batch))
+	{
+		for (int32 Frame=0; Frame<1000; ++Frame)
+		{
+			if (Frame %60 ==0) for (UAssemblyBuilderComponent* Assembly : Assemblies) Assembly->ApplyHighlightScalar((Frame /60) %2 ? 0.f :1.f);
+			HighlightFrame.Time([Batch]{ if (Batch->IsTickable()) Batch->Tick(1.f /60.f); });
+		}
+	}
+
+	for (ARobotActor* Robot : Robots) Robot->Destroy();
+
+	// Report
+	const FString Stamp = FDateTime::UtcNow().ToIso8601();
+	FString Json = FString::Printf(TEXT("{\n\t\"preset\": \"%s\", \"robots\": %d, \"parts\": %d, \"seed\": %d, \"engine\": \"%s\", \"timestamp\": \"%s\",\n\t\"results\": [\n"),
+		*Preset, NumRobots, NumParts, Seed, *FEngineVersion::Current().ToString(), *Stamp);
+	const FString CsvPath = OutDir / TEXT("ForgeFXPerf.csv");
+	FString Csv = FPaths::FileExists(CsvPath) ? FString() : FString(TEXT("timestamp,preset,robots,parts,op,samples,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n"));
+	const FSeries* All[] = { &Build, &Scramble, &DetachAll, &ReattachAll, &Nearest, &HighlightFrame };
+	for (int32 i=0; i<UE_ARRAY_COUNT(All); ++i)
+	{
+		const FSummary S = Summarize(All[i]->Ms);
+		Json += FString::Printf(TEXT("\t\t{ \"op\": \"%s\", \"samples\": %d, \"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p90_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f }%s\n"),
+			*All[i]->Name, S.Samples, S.Mean, S.P50, S.P90, S.P99, S.Max, i +1 < UE_ARRAY_COUNT(All) ? TEXT(",") : TEXT(""));
+		Csv += FString::Printf(TEXT("%s,%s,%d,%d,%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f\n"), *Stamp, *Preset, NumRobots, NumParts, *All[i]->Name, S.Samples, S.Mean, S.P50, S.P90, S.P99, S.Max);
+		AddInfo(FString::Printf(TEXT("%s: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms (%d samples)"), *All[i]->Name, S.P50, S.P90, S.P99, S.Samples));
+	}
+	Json += TEXT("\t]\n}\n");
+	const FString JsonPath = OutDir / (Preset + TEXT(".json"));
+	if (!FFileHelper::SaveStringToFile(Json, *JsonPath)) AddWarning(FString::Printf(TEXT("Could not write %s"), *JsonPath));
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append)) AddWarning(FString::Printf(TEXT("Could not write %s"), *CsvPath));
+	return true;
+}
+
+#endif // WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,34 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Components/AssemblySocketRegistry.h"
+
+// Pure data-structure test for the attach point registry (no world needed)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssemblySocketRegistryTest, "ForgeFX.Robot.Assembly.SocketRegistry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssemblySocketRegistryTest::RunTest(const FString& Parameters)
+{
+	FAssemblySocketRegistry Registry; Registry.Reset(50.f);
+	TArray<FVector> PartLocations = { FVector(0,0,0), FVector(100,0,0), FVector(0,300,0) };
+	for (int32 i=0; i<PartLocations.Num(); ++i) Registry.AddPart(i, nullptr); // origins only
+	auto Refresh = [&](){ Registry.Refresh([&](int32 Part){ return FTransform(PartLocations[Part]); }); };
+	Refresh();
+	TestFalse(TEXT("Refresh clears dirty parts"), Registry.HasDirty());
+
+	float Dist =0.f;
+	int32 Entry = Registry.FindNearest(FVector(90,0,0), 30.f, {}, Dist);
+	TestEqual(TEXT("Nearest within radius"), Entry != INDEX_NONE ? Registry.GetEntryPart(Entry) : INDEX_NONE, 1);
+	TestTrue(TEXT("Distance"), FMath::IsNearlyEqual(Dist, 10.f));
+
+	const int32 ExcludeOne[] = { 1 };
+	TestEqual(TEXT("Excluded part is skipped and nothing else is in range"), Registry.FindNearest(FVector(90,0,0), 30.f, ExcludeOne, Dist), INDEX_NONE);
+	Entry = Registry.FindNearest(FVector(90,0,0), 0.f, ExcludeOne, Dist);
+	TestEqual(TEXT("Unbounded search falls back to the next part"), Entry != INDEX_NONE ? Registry.GetEntryPart(Entry) : INDEX_NONE, 0);
+
+	// Only the moved part is refreshed, and it lands in its new cell
+	PartLocations[2] = FVector(95,5,0); Registry.MarkPartDirty(2); Refresh();
+	Entry = Registry.FindNearest(FVector(92,5,0), 10.f, {}, Dist);
+	TestEqual(TEXT("Moved part found in new cell"), Entry != INDEX_NONE ? Registry.GetEntryPart(Entry) : INDEX_NONE, 2);
+	TestEqual(TEXT("Old cell is empty"), Registry.FindNearest(FVector(0,300,0), 10.f, {}, Dist), INDEX_NONE);
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
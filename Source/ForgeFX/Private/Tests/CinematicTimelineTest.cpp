@@ -0,0 +1,42 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Data/CinematicTimeline.h"
+
+// Compiled timeline sampling: key order, easing tables, per-part tracks and stagger (no world needed).
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCinematicTimelineSamplerTest, "ForgeFX.Robot.Cinematic.TimelineSampler", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCinematicTimelineSamplerTest::RunTest(const FString& Parameters)
+{
+	UCinematicTimeline* Timeline = NewObject<UCinematicTimeline>();
+	Timeline->StaggerPerPart =0.25f;
+	FCinematicTrack& Default = Timeline->Tracks.AddDefaulted_GetRef();
+	FCinematicKey& Up = Default.Keys.AddDefaulted_GetRef(); Up.Time =1.f; Up.Offset = FVector(0,0,100); // authored out of order
+	Default.Keys.AddDefaulted(); // t=0 rest
+	FCinematicTrack& Head = Timeline->Tracks.AddDefaulted_GetRef(); Head.PartName = TEXT("Head"); Head.Delay =0.5f;
+	Head.Keys.AddDefaulted();
+	FCinematicKey& Out = Head.Keys.AddDefaulted_GetRef(); Out.Time =1.f; Out.ScatterAmount =200.f; Out.Ease = ECinematicEase::EaseIn; Out.EaseExponent =2.f;
+	FCinematicKey& Back = Head.Keys.AddDefaulted_GetRef(); Back.Time =2.f; Back.FollowRobot =1.f; Back.Ease = ECinematicEase::Step;
+
+	const TSharedRef<const FCinematicTimelineSampler> Sampler = Timeline->GetSampler();
+	TestTrue(TEXT("Sampler is shared"), &Timeline->GetSampler().Get() == &Sampler.Get());
+	const int32 DefaultTrack = Sampler->FindTrack(TEXT("Arm")), HeadTrack = Sampler->FindTrack(TEXT("Head"));
+	TestEqual(TEXT("Unknown part uses the default track"), DefaultTrack, 0);
+	TestEqual(TEXT("Head has its own track"), HeadTrack, 1);
+	TestEqual(TEXT("Duration includes delay"), Sampler->Duration, 2.5f);
+	TestEqual(TEXT("Stagger extends the total"), Sampler->GetTotalDuration(3), 3.f);
+
+	const FVector Home(10,0,0), Dir(1,0,0), Move(0,500,0);
+	TestTrue(TEXT("Keys sorted by time"), Sampler->Evaluate(DefaultTrack,0.5f, Home, Dir, Move).Equals(FVector(10,0,50)));
+	TestTrue(TEXT("Clamped before the first key"), Sampler->Evaluate(HeadTrack,0.25f, Home, Dir, Move).Equals(Home));
+	TestTrue(TEXT("Ease-in table"), Sampler->Evaluate(HeadTrack,1.f, Home, Dir, Move).Equals(FVector(60,0,0), 0.5f));
+	TestTrue(TEXT("Step holds the previous key"), Sampler->Evaluate(HeadTrack,2.4f, Home, Dir, Move).Equals(FVector(210,0,0)));
+	TestTrue(TEXT("Step lands on the robot destination"), Sampler->Evaluate(HeadTrack,2.5f, Home, Dir, Move).Equals(FVector(10,500,0)));
+
+	// Built-in fallback reproduces the old scatter/return flight
+	const FCinematicTimelineSampler Fallback = FCinematicTimelineSampler::MakeScatterReturn(1.f,1.f,300.f,2.f);
+	TestTrue(TEXT("Fallback scattered"), Fallback.Evaluate(0,1.f, Home, Dir, Move).Equals(FVector(310,0,0)));
+	TestTrue(TEXT("Fallback returns onto the moved robot"), Fallback.Evaluate(0,2.f, Home, Dir, Move).Equals(FVector(10,500,0)));
+	TestEqual(TEXT("Fallback moves the robot after scatter"), Fallback.RobotMoveTime, 1.f);
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,260 @@
+#include "Tests/ForgeFXSoakCommandlet.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+#include "UObject/UObjectIterator.h"
+#include "Actors/RobotActor.h"
+#include "Actors/RobotPartActor.h"
+#include "Components/AssemblyBuilderComponent.h"
+#include "Data/RobotAssemblyConfig.h"
+#include "Data/RobotAssemblyGenerator.h"
+#include "Subsystems/RobotPartActorPool.h"
+
+namespace ForgeFXSoak
+{
+	enum EMetric { UObjects, MIDs, PartActors, DetachedActors, PooledActors, Orphans, PreviewMIDs, PreviewMaterials, LastDetachTimes, SelectedParts, UsedMB, FrameMean, FrameP99, FrameMax, NumMetrics };
+
+	// Floor: absolute growth over the judged window that is still noise. Untrended columns are reported only.
+	struct FMetric { const TCHAR* Name; double Floor; bool bTrend; };
+	static const FMetric Metrics[NumMetrics] = {
+		{ TEXT("uobjects"), 256., true }, { TEXT("mids"), 16., true }, { TEXT("part_actors"), 4., true },
+		{ TEXT("detached_actors"), 0., false }, { TEXT("pooled_actors"), 4., true }, { TEXT("orphan_part_actors"), 0., true },
+		{ TEXT("preview_mids"), 0., true }, { TEXT("preview_materials"), 0., true }, { TEXT("last_detach_times"), 0., true },
+		{ TEXT("selected_parts"), 0., true }, { TEXT("used_physical_mb"), 64., true },
+		{ TEXT("frame_ms_mean"), 0.5, true }, { TEXT("frame_ms_p99"), 1., true }, { TEXT("frame_ms_max"), 0., false } };
+
+	enum EAction { Detach, Reattach, Scramble, Cinematic, Showcase, NumActions };
+	static const TCHAR* ActionNames[NumActions] = { TEXT("detach"), TEXT("reattach"), TEXT("scramble"), TEXT("cinematic"), TEXT("showcase") };
+
+	struct FSample { double WallSeconds =0, SimSeconds =0; int64 Frames =0, Actions =0; double V[NumMetrics] = {}; };
+
+	struct FRobot { ARobotActor* Actor = nullptr; UAssemblyBuilderComponent* Assembly = nullptr; FVector Home = FVector::ZeroVector; float Budget =0.f; };
+
+	static FSample TakeSample(UWorld* World, const TArray<FRobot>& Robots, const TArray<FName>& Detachable, TArray<double>& FrameMs)
+	{
+		FSample S;
+		S.V[UObjects] = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		for (TObjectIterator<UMaterialInstanceDynamic> It; It; ++It) S.V[MIDs] += 1.;
+
+		TSet<const ARobotPartActor*> Registered;
+		for (const FRobot& Robot : Robots)
+		{
+			if (!IsValid(Robot.Actor) || !Robot.Assembly) continue;
+			for (const FName Name : Detachable) if (const ARobotPartActor* Actor = Robot.Assembly->GetDetachedActor(Name)) Registered.Add(Actor);
+			int32 NumPreviewMIDs =0, NumPreviewMaterials =0, NumLastDetach =0, NumSelected =0;
+			Robot.Actor->GetBookkeepingCounts(NumPreviewMIDs, NumPreviewMaterials, NumLastDetach, NumSelected);
+			S.V[PreviewMIDs] += NumPreviewMIDs; S.V[PreviewMaterials] += NumPreviewMaterials; S.V[LastDetachTimes] += NumLastDetach; S.V[SelectedParts] += NumSelected;
+		}
+
+		// Orphans: named part actors no assembly owns, plus unnamed (parked) ones the pool does not hold
+		const URobotPartActorPool* Pool = URobotPartActorPool::Get(World);
+		const int32 Pooled = Pool ? Pool->GetStats().Idle :0;
+		int32 Named =0, Unnamed =0, NamedOrphans =0;
+		for (TActorIterator<ARobotPartActor> It(World); It; ++It)
+		{
+			if (It->GetPartName().IsNone()) { ++Unnamed; continue; }
+			++Named; if (!Registered.Contains(*It)) ++NamedOrphans;
+		}
+		S.V[PartActors] = Named + Unnamed; S.V[DetachedActors] = Registered.Num(); S.V[PooledActors] = Pooled;
+		S.V[Orphans] = NamedOrphans + FMath::Max(Unnamed - Pooled, 0);
+		S.V[UsedMB] = FPlatformMemory::GetStats().UsedPhysical / (1024. * 1024.);
+
+		if (FrameMs.Num() >0)
+		{
+			for (const double Ms : FrameMs) S.V[FrameMean] += Ms;
+			S.V[FrameMean] /= FrameMs.Num();
+			FrameMs.Sort(); // nearest rank
+			S.V[FrameP99] = FrameMs[FMath::Clamp(FMath::CeilToInt32(0.99 * FrameMs.Num()) -1, 0, FrameMs.Num() -1)];
+			S.V[FrameMax] = FrameMs.Last();
+		}
+		return S;
+	}
+
+	static void DoAction(FRobot& Robot, const TArray<FName>& Detachable, FRandomStream& Rng, int64 (&Counts)[NumActions])
+	{
+		const float Roll = Rng.FRand();
+		const FName Part = Detachable.Num() >0 ? Detachable[Rng.RandRange(0, Detachable.Num() -1)] : NAME_None;
+		// Detach / reattach dominate; calls that would be no-ops (already detached, already attached) are not counted
+		if (Roll <0.45f) { if (Robot.Actor->DetachPartForTest(Part)) ++Counts[Detach]; }
+		else if (Roll <0.9f) { if (Robot.Actor->ReattachPartForTest(Part)) ++Counts[Reattach]; }
+		else if (Roll <0.94f) { Robot.Actor->ScrambleParts(); ++Counts[Scramble]; }
+		else if (Roll <0.98f) { Robot.Actor->TriggerCinematicAssemble(Robot.Home + FVector(Rng.FRandRange(-300.f, 300.f), Rng.FRandRange(-300.f, 300.f), 0.f)); ++Counts[Cinematic]; }
+		else
+		{
+			if (Robot.Actor->IsShowcaseActive()) Robot.Actor->StopShowcase(); else Robot.Actor->StartShowcase();
+			++Counts[Showcase];
+		}
+	}
+}
+
+UForgeFXSoakCommandlet::UForgeFXSoakCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UForgeFXSoakCommandlet::Main(const FString& Params)
+{
+	using namespace ForgeFXSoak;
+	double Minutes =60.;
+	int32 NumRobots =32, NumParts =24, Seed =1, WarmupPercent =20;
+	float ActionsPerSecond =5.f, SampleSeconds =10.f, LeakTolerance =0.1f;
+	FString OutDir = FPaths::ProjectSavedDir() / TEXT("Soak"), RobotClassPath;
+	FParse::Value(*Params, TEXT("Minutes="), Minutes);
+	FParse::Value(*Params, TEXT("Robots="), NumRobots);
+	FParse::Value(*Params, TEXT("Parts="), NumParts);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("ActionsPerSecond="), ActionsPerSecond);
+	FParse::Value(*Params, TEXT("SampleSeconds="), SampleSeconds);
+	FParse::Value(*Params, TEXT("LeakTolerance="), LeakTolerance);
+	FParse::Value(*Params, TEXT("WarmupPercent="), WarmupPercent);
+	FParse::Value(*Params, TEXT("Out="), OutDir);
+	FParse::Value(*Params, TEXT("RobotClass="), RobotClassPath); // e.g. a Blueprint robot, /Game/Robot/BP_Robot.BP_Robot_C
+	const bool bFailOnLeak = FParse::Param(*Params, TEXT("FailOnLeak"));
+	NumRobots = FMath::Max(NumRobots, 1); NumParts = FMath::Max(NumParts, 2);
+	SampleSeconds = FMath::Max(SampleSeconds, 0.1f); WarmupPercent = FMath::Clamp(WarmupPercent, 0, 90);
+	const float Dt =1.f /60.f; // fixed simulated step; the loop runs as fast as the machine allows
+
+	UClass* RobotClass = RobotClassPath.IsEmpty() ? ARobotActor::StaticClass() : LoadClass<ARobotActor>(nullptr, *RobotClassPath);
+	if (!RobotClass) { UE_LOG(LogTemp, Error, TEXT("ForgeFXSoak: robot class %s not found"), *RobotClassPath); return 1; }
+
+	FRobotAssemblyGenSettings Gen; Gen.Seed = Seed; Gen.NumParts = NumParts;
+	URobotAssemblyConfig* Config = URobotAssemblyGenerator::GenerateAssemblyConfig(Gen);
+	Config->AddToRoot(); // survives the periodic GC before the assemblies reference it
+	TArray<FName> Detachable; for (const FRobotPartSpec& Spec : Config->Parts) if (Spec.bDetachable) Detachable.Add(Spec.PartName);
+
+	// Game world owned by a standalone game instance (world context included), so SetGameMode can spawn the game mode
+	// and BeginPlay reaches the actors: robots bind their delegates and timers the way they do in a level
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone(TEXT("ForgeFXSoak"));
+	UWorld* World = GameInstance->GetWorld();
+	if (!World) { UE_LOG(LogTemp, Error, TEXT("ForgeFXSoak: could not create a game world")); GameInstance->RemoveFromRoot(); Config->RemoveFromRoot(); return 1; }
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	TArray<FRobot> Robots;
+	for (int32 r=0; r<NumRobots; ++r)
+	{
+		const FTransform Home(FVector((r %8) *500.f, (r /8) *500.f, 0.f));
+		ARobotActor* Actor = World->SpawnActorDeferred<ARobotActor>(RobotClass, Home);
+		if (!Actor) continue;
+		UAssemblyBuilderComponent* Assembly = Actor->FindComponentByClass<UAssemblyBuilderComponent>();
+		if (Assembly) { Assembly->AssemblyConfig = Config; Assembly->bAsyncMeshLoading = false; }
+		Actor->FinishSpawning(Home);
+		Robots.Add({ Actor, Assembly, Home.GetLocation() });
+	}
+	UE_LOG(LogTemp, Display, TEXT("ForgeFXSoak: %d robots x %d parts (%d detachable), %.1f actions/s per robot, %.1f min, sampling every %.1f s"),
+		Robots.Num(), Config->Parts.Num(), Detachable.Num(), ActionsPerSecond, Minutes, SampleSeconds);
+
+	FRandomStream Rng(Seed);
+	int64 Counts[NumActions] = {};
+	int64 Frames =0; double SimSeconds =0.;
+	TArray<double> FrameMs; TArray<FSample> Samples;
+	const double Start = FPlatformTime::Seconds(), End = Start + Minutes *60.;
+	double NextSample = Start;
+	while (!IsEngineExitRequested())
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= NextSample || Now >= End)
+		{
+			// Sample after a full GC so counts reflect what is actually kept alive
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			FlushRenderingCommands();
+			FSample& S = Samples.Add_GetRef(TakeSample(World, Robots, Detachable, FrameMs));
+			S.WallSeconds = Now - Start; S.SimSeconds = SimSeconds; S.Frames = Frames;
+			for (const int64 Count : Counts) S.Actions += Count;
+			UE_LOG(LogTemp, Display, TEXT("ForgeFXSoak %6.0fs: %lld actions, uobjects %.0f, mids %.0f, part actors %.0f (pooled %.0f, orphans %.0f), %.0f MB, frame %.2f / p99 %.2f ms"),
+				S.WallSeconds, S.Actions, S.V[UObjects], S.V[MIDs], S.V[PartActors], S.V[PooledActors], S.V[Orphans], S.V[UsedMB], S.V[FrameMean], S.V[FrameP99]);
+			FrameMs.Reset();
+			NextSample = Now + SampleSeconds;
+			if (Now >= End) break;
+		}
+
+		const uint64 FrameStart = FPlatformTime::Cycles64();
+		for (FRobot& Robot : Robots)
+		{
+			if (!IsValid(Robot.Actor)) continue;
+			for (Robot.Budget += ActionsPerSecond * Dt; Robot.Budget >=1.f; Robot.Budget -=1.f) DoAction(Robot, Detachable, Rng, Counts);
+		}
+		World->Tick(LEVELTICK_All, Dt);
+		++GFrameCounter; ++Frames; SimSeconds += Dt;
+		FrameMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - FrameStart));
+	}
+
+	for (const FRobot& Robot : Robots) if (IsValid(Robot.Actor)) Robot.Actor->Destroy();
+	World->BeginTearingDown();
+	GameInstance->Shutdown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot(); Config->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	// Trends: least-squares slope per hour over the samples after warm-up (pools and caches fill during warm-up).
+	// A trended column is flagged when its fitted growth over that window beats both its floor and LeakTolerance.
+	const FString Stamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	FString Csv = TEXT("wall_s,sim_s,frames,actions");
+	for (const FMetric& Metric : Metrics) Csv += FString(TEXT(",")) + Metric.Name;
+	Csv += TEXT("\n");
+	for (const FSample& S : Samples)
+	{
+		Csv += FString::Printf(TEXT("%.1f,%.1f,%lld,%lld"), S.WallSeconds, S.SimSeconds, S.Frames, S.Actions);
+		for (const double V : S.V) Csv += FString::Printf(TEXT(",%.3f"), V);
+		Csv += TEXT("\n");
+	}
+
+	FString Summary = FString::Printf(TEXT("ForgeFX soak %s: %d robots x %d parts, seed %d, %.1f min wall, %.1f min simulated, %lld frames\nactions:"),
+		*Stamp, Robots.Num(), Config->Parts.Num(), Seed, Samples.Num() >0 ? Samples.Last().WallSeconds /60. :0., SimSeconds /60., Frames);
+	for (int32 a=0; a<NumActions; ++a) Summary += FString::Printf(TEXT(" %s %lld"), ActionNames[a], Counts[a]);
+	Summary += TEXT("\n\nmetric                  first       last        min         max         slope/h     verdict\n");
+
+	bool bLeak = false;
+	const int32 FirstJudged = FMath::Min(Samples.Num() * WarmupPercent /100, FMath::Max(Samples.Num() -2, 0));
+	const int32 NumJudged = Samples.Num() - FirstJudged;
+	for (int32 m=0; m<NumMetrics; ++m)
+	{
+		if (NumJudged <2) break;
+		double Min = TNumericLimits<double>::Max(), Max = TNumericLimits<double>::Lowest(), MeanX =0., MeanY =0.;
+		for (int32 i=FirstJudged; i<Samples.Num(); ++i)
+		{
+			const double Y = Samples[i].V[m]; Min = FMath::Min(Min, Y); Max = FMath::Max(Max, Y);
+			MeanX += Samples[i].WallSeconds /3600.; MeanY += Y;
+		}
+		MeanX /= NumJudged; MeanY /= NumJudged;
+		double Sxy =0., Sxx =0.;
+		for (int32 i=FirstJudged; i<Samples.Num(); ++i)
+		{
+			const double X = Samples[i].WallSeconds /3600. - MeanX; Sxy += X * (Samples[i].V[m] - MeanY); Sxx += X * X;
+		}
+		const double Slope = Sxx >0. ? Sxy / Sxx :0.;
+		const double First = Samples[FirstJudged].V[m], Growth = Slope * (Samples.Last().WallSeconds - Samples[FirstJudged].WallSeconds) /3600.;
+		const bool bGrows = Metrics[m].bTrend && Growth > FMath::Max(Metrics[m].Floor, LeakTolerance * FMath::Abs(First));
+		bLeak |= bGrows;
+		Summary += FString::Printf(TEXT("%-22s  %-10.2f  %-10.2f  %-10.2f  %-10.2f  %-+10.2f  %s\n"), Metrics[m].Name, First, Samples.Last().V[m], Min, Max, Slope,
+			!Metrics[m].bTrend ? TEXT("-") : bGrows ? TEXT("GROWING") : TEXT("ok"));
+	}
+	Summary += NumJudged <2 ? TEXT("\nToo few samples after warm-up to judge trends; run longer or lower -SampleSeconds.\n")
+		: bLeak ? TEXT("\nGrowth detected: see GROWING rows.\n") : TEXT("\nNo growth detected.\n");
+
+	const FString CsvPath = OutDir / FString::Printf(TEXT("ForgeFXSoak_%s.csv"), *Stamp);
+	const FString SummaryPath = OutDir / FString::Printf(TEXT("ForgeFXSoak_%s.txt"), *Stamp);
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath)) UE_LOG(LogTemp, Warning, TEXT("ForgeFXSoak: could not write %s"), *CsvPath);
+	if (!FFileHelper::SaveStringToFile(Summary, *SummaryPath)) UE_LOG(LogTemp, Warning, TEXT("ForgeFXSoak: could not write %s"), *SummaryPath);
+	TArray<FString> Lines; Summary.ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines) UE_LOG(LogTemp, Display, TEXT("%s"), *Line);
+	UE_LOG(LogTemp, Display, TEXT("ForgeFXSoak: samples in %s"), *CsvPath);
+	return bLeak && bFailOnLeak ? 1 :0;
+}
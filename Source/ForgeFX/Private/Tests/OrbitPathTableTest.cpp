@@ -0,0 +1,27 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Actors/OrbitCameraRig.h"
+
+// Shared orbit path tables: cache reuse, analytic fast path and arc-length spacing (no world needed).
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOrbitPathTableTest, "ForgeFX.Robot.Showcase.OrbitPathTable", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOrbitPathTableTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<const FOrbitPathTable> Fine = FOrbitPathTable::Get(650.f,150.f,64);
+	TestTrue(TEXT("Same key shares one table"), &FOrbitPathTable::Get(650.f,150.f,64).Get() == &Fine.Get());
+	TestTrue(TEXT("Dense control points use the analytic circle"), Fine->bAnalyticCircle);
+	TestTrue(TEXT("Analytic start"), Fine->Evaluate(0.f).Equals(FVector(650,0,150), 0.01f));
+	TestTrue(TEXT("Analytic quarter lap"), Fine->Evaluate(1.25f).Equals(FVector(0,650,150), 0.01f));
+
+	const TSharedRef<const FOrbitPathTable> Coarse = FOrbitPathTable::Get(500.f,100.f,4);
+	TestFalse(TEXT("Four control points need the table"), Coarse->bAnalyticCircle);
+	TestEqual(TEXT("Table size"), Coarse->Samples.Num(), FOrbitPathTable::NumSamples);
+	TestTrue(TEXT("Path starts on the first control point"), Coarse->Evaluate(0.f).Equals(FVector(500,0,100), 0.5f));
+	// Equal parameter steps cover equal distance along the closed path
+	const float Step = FVector::Dist(Coarse->Evaluate(0.f), Coarse->Evaluate(1.f / 64));
+	float MaxDev =0.f;
+	for (int32 i=1; i<64; ++i) MaxDev = FMath::Max(MaxDev, FMath::Abs(FVector::Dist(Coarse->Evaluate(float(i) / 64), Coarse->Evaluate(float(i +1) / 64)) - Step));
+	TestTrue(TEXT("Arc-length parameterized"), MaxDev < Step *0.05f);
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
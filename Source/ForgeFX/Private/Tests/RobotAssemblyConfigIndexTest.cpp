@@ -0,0 +1,72 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Data/RobotAssemblyConfig.h"
+
+// Validates the name -> spec index on URobotAssemblyConfig (no world needed).
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobotAssemblyConfigIndexTest, "ForgeFX.Robot.Assembly.ConfigPartIndex", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRobotAssemblyConfigIndexTest::RunTest(const FString& Parameters)
+{
+	URobotAssemblyConfig* Config = NewObject<URobotAssemblyConfig>();
+	for (const TCHAR* Name : { TEXT("Torso"), TEXT("Head"), TEXT("Hand_Left") })
+	{
+		FRobotPartSpec Spec; Spec.PartName = FName(Name); Config->Parts.Add(Spec);
+	}
+	Config->RebuildPartIndex();
+
+	const FRobotPartSpec* Head = Config->FindPartSpec(TEXT("Head"));
+	TestNotNull(TEXT("Head found"), Head);
+	TestTrue(TEXT("Lookup returns a pointer into Parts (no copy)"), Head == &Config->Parts[1]);
+	TestNull(TEXT("Unknown part"), Config->FindPartSpec(TEXT("Tail")));
+
+	// Appending from code without an explicit rebuild is picked up by the count check
+	FRobotPartSpec Extra; Extra.PartName = TEXT("Foot_Right"); Config->Parts.Add(Extra);
+	TestEqual(TEXT("Appended part indexed"), Config->FindPartIndex(TEXT("Foot_Right")), 3);
+
+	// Reordering in place is caught by the stale-slot check
+	Config->Parts.Swap(0, 1);
+	TestEqual(TEXT("Torso after swap"), Config->FindPartIndex(TEXT("Torso")), 1);
+	TestEqual(TEXT("Head after swap"), Config->FindPartIndex(TEXT("Head")), 0);
+
+	// Renaming in place to a name the index has never seen is caught on the miss
+	Config->Parts[2].PartName = TEXT("Claw_Left");
+	TestEqual(TEXT("Renamed part found"), Config->FindPartIndex(TEXT("Claw_Left")), 2);
+	TestNull(TEXT("Old name gone"), Config->FindPartSpec(TEXT("Hand_Left")));
+	TestNull(TEXT("Repeated miss stays a miss"), Config->FindPartSpec(TEXT("Tail")));
+	return true;
+}
+
+// Build plan: parents precede children regardless of config order; cycles fall back to the root
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobotAssemblyBuildPlanTest, "ForgeFX.Robot.Assembly.ConfigBuildPlan", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRobotAssemblyBuildPlanTest::RunTest(const FString& Parameters)
+{
+	URobotAssemblyConfig* Config = NewObject<URobotAssemblyConfig>();
+	auto AddPart = [Config](const TCHAR* Name, const TCHAR* Parent){ FRobotPartSpec Spec; Spec.PartName = FName(Name); Spec.ParentPartName = Parent ? FName(Parent) : NAME_None; Config->Parts.Add(Spec); };
+	AddPart(TEXT("Hand"), TEXT("Arm")); // child listed before its parent
+	AddPart(TEXT("Arm"), TEXT("Torso"));
+	AddPart(TEXT("Torso"), nullptr);
+	AddPart(TEXT("LoopA"), TEXT("LoopB"));
+	AddPart(TEXT("LoopB"), TEXT("LoopA"));
+
+	const FRobotAssemblyBuildPlan& Plan = Config->GetBuildPlan();
+	TestEqual(TEXT("Every spec is scheduled once"), Plan.Order.Num(), Config->Parts.Num());
+	TestTrue(TEXT("Torso before Arm"), Plan.Order.IndexOfByKey(2) < Plan.Order.IndexOfByKey(1));
+	TestTrue(TEXT("Arm before Hand"), Plan.Order.IndexOfByKey(1) < Plan.Order.IndexOfByKey(0));
+	TestEqual(TEXT("Hand parent resolved"), Plan.ParentSpecIndex[0], 1);
+	TestEqual(TEXT("Cycle attaches to root"), Plan.ParentSpecIndex[3], (int32)INDEX_NONE);
+	TestTrue(TEXT("Plan is shared"), &Config->GetBuildPlan() == &Plan);
+
+	// Re-parenting in place from code is detected without an explicit rebuild
+	Config->Parts[0].ParentPartName = TEXT("Torso");
+	TestEqual(TEXT("Plan rebuilt after edit"), Config->GetBuildPlan().ParentSpecIndex[0], 2);
+
+	// Swapping a mesh from code drops meshes resolved for the old path
+	Config->Parts[2].Mesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")));
+	TestNotNull(TEXT("Mesh resolved"), Config->GetBuildPlan().ResolveMesh(Config->Parts[2], 2, true));
+	Config->Parts[2].Mesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Engine/BasicShapes/Sphere.Sphere")));
+	const UStaticMesh* Swapped = Config->GetBuildPlan().ResolveMesh(Config->Parts[2], 2, true);
+	TestTrue(TEXT("Swapped mesh resolved, not the stale one"), Swapped && Swapped->GetName() == TEXT("Sphere"));
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -80,11 +80,7 @@ bool FRobotAssemblyFunctionalTest::RunTest(const FString& Parameters)
 	{
 		if (!Assembly->IsPartDetached(P)) continue; // skip if failure earlier
 		// find actor
-		ARobotPartActor* PartActor = nullptr;
-		for (TActorIterator<ARobotPartActor> It(World); It; ++It)
-		{
-			if (It->GetPartName() == P) { PartActor = *It; break; }
-		}
+		ARobotPartActor* PartActor = Assembly->GetDetachedActor(P);
 		const bool bReattached = PartActor && Assembly->ReattachPart(P, PartActor);
 		TestTrue(FString::Printf(TEXT("Reattach %s"), *P.ToString()), bReattached);
 	}
@@ -0,0 +1,47 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Data/RobotAssemblyConfig.h"
+#include "Data/RobotAssemblyGenerator.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobotAssemblyGeneratorTest, "ForgeFX.Robot.Assembly.Generator", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRobotAssemblyGeneratorTest::RunTest(const FString& Parameters)
+{
+	FRobotAssemblyGenSettings Settings; Settings.Seed =7;
+	for (const int32 NumParts : { 10, 100, 1000 })
+	{
+		Settings.NumParts = NumParts;
+		const URobotAssemblyConfig* A = URobotAssemblyGenerator::GenerateAssemblyConfig(Settings);
+		const URobotAssemblyConfig* B = URobotAssemblyGenerator::GenerateAssemblyConfig(Settings);
+		TestEqual(FString::Printf(TEXT("%d parts generated"), NumParts), A->Parts.Num(), NumParts);
+		TestEqual(TEXT("Root is the Torso"), A->Parts[0].PartName, FName(TEXT("Torso")));
+
+		// Parents are listed first and the plan schedules everything without falling back to the root
+		bool bParentsFirst = true, bSame = true;
+		const FRobotAssemblyBuildPlan& Plan = A->GetBuildPlan();
+		for (int32 i=1; i<A->Parts.Num(); ++i)
+		{
+			bParentsFirst &= Plan.ParentSpecIndex[i] != INDEX_NONE && Plan.ParentSpecIndex[i] < i;
+			const FRobotPartSpec& X = A->Parts[i]; const FRobotPartSpec& Y = B->Parts[i];
+			bSame &= X.PartName == Y.PartName && X.ParentPartName == Y.ParentPartName && X.ParentSocketName == Y.ParentSocketName
+				&& X.Mesh == Y.Mesh && X.bDetachable == Y.bDetachable && X.RelativeTransform.Equals(Y.RelativeTransform);
+		}
+		TestTrue(TEXT("Every part hangs off an earlier part"), bParentsFirst);
+		TestTrue(TEXT("Same seed, same config"), bSame);
+	}
+
+	// Depth and branching cap the tree
+	Settings.NumParts =1000; Settings.MaxDepth =2; Settings.BranchingFactor =3; Settings.SocketsPerPart =0;
+	TestEqual(TEXT("Capped at 1 + 3 + 9 parts"), URobotAssemblyGenerator::GenerateAssemblyConfig(Settings)->Parts.Num(), 13);
+
+	// A different seed changes the layout
+	Settings.NumParts =50; Settings.MaxDepth =8;
+	const URobotAssemblyConfig* C = URobotAssemblyGenerator::GenerateAssemblyConfig(Settings);
+	Settings.Seed =8;
+	const URobotAssemblyConfig* D = URobotAssemblyGenerator::GenerateAssemblyConfig(Settings);
+	bool bDiffers = false;
+	for (int32 i=1; i<C->Parts.Num(); ++i) bDiffers |= !C->Parts[i].RelativeTransform.Equals(D->Parts[i].RelativeTransform);
+	TestTrue(TEXT("Different seed, different config"), bDiffers);
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -18,6 +18,13 @@ bool FRobotDetachReattachTest::RunTest(const FString& Parameters)
 	for (FName P : Parts){ const bool bDetached = Robot->DetachPartForTest(P); TestTrue(*FString::Printf(TEXT("Detached %s"), *P.ToString()), bDetached); }
 	// Validate each now detached
 	for (FName P : Parts){ TestTrue(*FString::Printf(TEXT("State detached %s"), *P.ToString()), Robot->IsPartCurrentlyDetached(P)); }
+	// A second detach must not replace (and orphan) the registered actor
+	if (UAssemblyBuilderComponent* Assembly = Robot->FindComponentByClass<UAssemblyBuilderComponent>())
+	{
+		ARobotPartActor* Registered = Assembly->GetDetachedActor(Parts[0]); ARobotPartActor* Again = nullptr;
+		TestFalse(TEXT("Detaching a detached part is refused"), Assembly->DetachPart(Parts[0], Again));
+		TestTrue(TEXT("Registered actor kept"), Assembly->GetDetachedActor(Parts[0]) == Registered);
+	}
 	// Reattach all
 	for (FName P : Parts){ const bool bReattached = Robot->ReattachPartForTest(P); TestTrue(*FString::Printf(TEXT("Reattached %s"), *P.ToString()), bReattached); }
 	// Validate attached
@@ -0,0 +1,46 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Actors/RobotActor.h"
+#include "Components/AssemblyBuilderComponent.h"
+
+static UWorld* GetAutomationWorldHide(){ if (!GEngine) return nullptr; for (const FWorldContext& Ctx : GEngine->GetWorldContexts()){ if (Ctx.WorldType==EWorldType::PIE && Ctx.World()) return Ctx.World(); } return nullptr; }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobotHideVerifyTest, "RobotTests.DetachedHideVerify", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRobotHideVerifyTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = GetAutomationWorldHide(); if (!World){ AddWarning(TEXT("No PIE world active")); return true; }
+	ARobotActor* Robot = World->SpawnActor<ARobotActor>(); TestNotNull(TEXT("Robot spawned"), Robot); if (!Robot) return false;
+	UAssemblyBuilderComponent* Assembly = Robot->FindComponentByClass<UAssemblyBuilderComponent>(); if (!Assembly) return false;
+	TArray<FName> Parts = Robot->GetDetachableParts(); if (Parts.Num()==0){ AddWarning(TEXT("No detachable parts")); return true; }
+	for (FName P : Parts) Robot->DetachPartForTest(P);
+	// Hide is applied on the transition, so a verify pass right after has nothing to repair
+	TestEqual(TEXT("Nothing drifted after detach"), Assembly->VerifyDetachedHidden(), 0);
+	const FName Probe = Parts[0];
+	if (!Assembly->IsPartInstanced(Probe))
+	{
+		if (UStaticMeshComponent* Comp = Assembly->GetPartByName(Probe))
+		{
+			Comp->SetHiddenInGame(false); Comp->SetVisibility(true, false); // this part only; children have their own state
+			TestEqual(TEXT("Drifted part repaired"), Assembly->VerifyDetachedHidden(), 1);
+			TestTrue(TEXT("Drifted part hidden again"), Comp->bHiddenInGame && !Comp->IsVisible());
+			TestEqual(TEXT("Second pass is a no-op"), Assembly->VerifyDetachedHidden(), 0);
+		}
+	}
+	// Reattaching a parent shows it again; its still-detached children must stay hidden
+	for (FName P : Parts)
+	{
+		FRobotPartSpec Spec; if (!Assembly->GetPartSpec(P, Spec) || !Parts.Contains(Spec.ParentPartName) || Assembly->IsPartInstanced(P)) continue;
+		Robot->ReattachPartForTest(Spec.ParentPartName);
+		const UStaticMeshComponent* Child = Assembly->GetPartByName(P);
+		TestTrue(TEXT("Detached child stays hidden after its parent reattaches"), Child && !Child->IsVisible());
+		TestEqual(TEXT("Nothing to repair after reattach"), Assembly->VerifyDetachedHidden(), 0);
+		break;
+	}
+	for (FName P : Parts) Robot->ReattachPartForTest(P);
+	Robot->Destroy();
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,47 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Actors/RobotActor.h"
+#include "Components/AssemblyBuilderComponent.h"
+#include "Components/PartInteractionComponent.h"
+#include "Data/RobotAssemblyConfig.h"
+#include "Data/RobotAssemblyGenerator.h"
+
+static UWorld* GetAutomationWorldClick(){ if (!GEngine) return nullptr; for (const FWorldContext& Ctx : GEngine->GetWorldContexts()){ if (Ctx.WorldType==EWorldType::PIE && Ctx.World()) return Ctx.World(); } return nullptr; }
+
+// Clicking an instance of a shared ISMC detaches the part under the cursor, not whichever part owns the component
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobotInstancedClickDetachTest, "RobotTests.InstancedClickDetach", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRobotInstancedClickDetachTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = GetAutomationWorldClick(); if (!World){ AddWarning(TEXT("No PIE world active")); return true; }
+	FRobotAssemblyGenSettings Gen; Gen.NumParts =6; Gen.SocketsPerPart =0; Gen.Shapes = { ERobotGenShape::Cube }; // one mesh, one shared ISMC
+
+	ARobotActor* Robot = World->SpawnActorDeferred<ARobotActor>(ARobotActor::StaticClass(), FTransform(FVector(0,0,200)));
+	TestNotNull(TEXT("Robot spawned"), Robot); if (!Robot) return false;
+	UAssemblyBuilderComponent* Assembly = Robot->FindComponentByClass<UAssemblyBuilderComponent>();
+	UPartInteractionComponent* Interaction = Robot->FindComponentByClass<UPartInteractionComponent>();
+	if (!TestNotNull(TEXT("Assembly"), Assembly) || !TestNotNull(TEXT("Part interaction"), Interaction)) { Robot->FinishSpawning(FTransform::Identity); Robot->Destroy(); return false; }
+	Assembly->AssemblyConfig = URobotAssemblyGenerator::GenerateAssemblyConfig(Gen); Assembly->bUseInstancedComponents = true; Assembly->bAsyncMeshLoading = false;
+	Robot->FinishSpawning(FTransform(FVector(0,0,200)));
+
+	// A middle part, so neither the first nor the last instance on the ISMC matches by accident
+	const int32 Target = Assembly->FindPartHandle(TEXT("Part2"));
+	UStaticMeshComponent* ISMC = Assembly->GetPartComponentByHandle(Target);
+	TestTrue(TEXT("Target part is instanced"), Assembly->GetPartInstanceIndexByHandle(Target) != INDEX_NONE);
+	TestTrue(TEXT("Shared ISMC"), ISMC && ISMC == Assembly->GetPartComponentByHandle(Assembly->FindPartHandle(TEXT("Part1"))));
+
+	TestTrue(TEXT("Click starts a drag"), Interaction->HandleInteractPressed(ISMC, Robot, false, 8.f, 10.f, 50.f, 500.f, Assembly->GetPartInstanceIndexByHandle(Target)));
+	TestEqual(TEXT("Dragging the clicked part"), Interaction->GetDraggedPartName(), FName(TEXT("Part2")));
+	for (int32 Handle=0; Handle<Assembly->GetNumParts(); ++Handle)
+	{
+		const FName Name = Assembly->GetPartNameByHandle(Handle);
+		TestEqual(*FString::Printf(TEXT("Only the clicked part detached (%s)"), *Name.ToString()), Assembly->IsPartDetachedByHandle(Handle), Handle == Target);
+	}
+	Interaction->ForceDropHeldPart(false);
+	Assembly->ReattachDetachedPart(TEXT("Part2"));
+	Robot->Destroy();
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
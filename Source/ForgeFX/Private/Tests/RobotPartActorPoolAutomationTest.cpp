@@ -0,0 +1,42 @@
+#if WITH_DEV_AUTOMATION_TESTS
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Actors/RobotPartActor.h"
+#include "Subsystems/RobotPartActorPool.h"
+
+static UWorld* GetAutomationWorldPool(){ if (!GEngine) return nullptr; for (const FWorldContext& Ctx : GEngine->GetWorldContexts()){ if (Ctx.WorldType==EWorldType::PIE && Ctx.World()) return Ctx.World(); } return nullptr; }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobotPartActorPoolTest, "RobotTests.PartActorPool", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRobotPartActorPoolTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = GetAutomationWorldPool(); if (!World){ AddWarning(TEXT("No PIE world active")); return true; }
+	URobotPartActorPool* Pool = URobotPartActorPool::Get(World); TestNotNull(TEXT("Pool subsystem"), Pool); if (!Pool) return false;
+	Pool->Drain(); Pool->ResetStats();
+
+	ARobotPartActor* First = Pool->Acquire(ARobotPartActor::StaticClass(), FTransform(FVector(0,0,100)));
+	TestNotNull(TEXT("Spawned on miss"), First); if (!First) return false;
+	TestEqual(TEXT("Miss counted"), Pool->GetStats().Misses, 1);
+	First->InitializePart(TEXT("PoolProbe"), nullptr, {});
+	const bool bDefaultOverlaps = First->GetMeshComponent()->GetGenerateOverlapEvents();
+	First->GetMeshComponent()->SetGenerateOverlapEvents(!bDefaultOverlaps); // e.g. a cinematic flight
+	Pool->Release(First);
+	TestTrue(TEXT("Parked actor is hidden"), First->IsHidden());
+	TestTrue(TEXT("Parked actor has no part name"), First->GetPartName().IsNone());
+	Pool->Release(First);
+	TestEqual(TEXT("Releasing a parked actor again is ignored"), Pool->GetStats().Idle, 1);
+
+	ARobotPartActor* Second = Pool->Acquire(ARobotPartActor::StaticClass(), FTransform(FVector(50,0,100)));
+	TestTrue(TEXT("Released actor is reused"), Second == First);
+	TestEqual(TEXT("Hit counted"), Pool->GetStats().Hits, 1);
+	TestFalse(TEXT("Reused actor is visible"), Second->IsHidden());
+	TestTrue(TEXT("Reused actor moved"), Second->GetActorLocation().Equals(FVector(50,0,100)));
+	TestEqual(TEXT("Reused actor has the class default overlap setting"), Second->GetMeshComponent()->GetGenerateOverlapEvents(), bDefaultOverlaps);
+
+	Pool->Prewarm(ARobotPartActor::StaticClass(), 3);
+	TestEqual(TEXT("Prewarm parks idle actors"), Pool->GetStats().Idle, 3);
+	Second->Destroy(); Pool->Drain();
+	return true;
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
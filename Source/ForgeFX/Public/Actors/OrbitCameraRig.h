@@ -5,7 +5,24 @@
 #include "OrbitCameraRig.generated.h"
 
 class UCameraComponent; 
-class USplineComponent;
+
+/**
+ * Closed orbit path through NumPoints points on a circle (Radius, Height above the target), resampled by arc length
+ * so a uniform parameter gives uniform camera speed. Tables are built once per (radius, height, points) and shared
+ * by every rig. Paths that are indistinguishable from the circle skip the table and evaluate it analytically.
+ */
+struct FORGEFX_API FOrbitPathTable
+{
+	static constexpr int32 NumSamples =256;
+	float Radius =0.f, Height =0.f;
+	bool bAnalyticCircle = true;
+	TArray<FVector> Samples; // offsets from the target, equal arc length apart; empty when analytic
+
+	// Shared table (game thread); NumPoints <3 gives the exact circle
+	static TSharedRef<const FOrbitPathTable> Get(float Radius, float Height, int32 NumPoints);
+	// Offset from the target at path parameter T (wraps, 1 = one lap)
+	FVector Evaluate(float T) const;
+};
 
 UCLASS()
 class FORGEFX_API AOrbitCameraRig : public AActor
@@ -34,9 +51,8 @@ protected:
 private:
 	UPROPERTY(VisibleAnywhere) TObjectPtr<USceneComponent> Root;
 	UPROPERTY(VisibleAnywhere) TObjectPtr<UCameraComponent> Camera;
-	UPROPERTY(VisibleAnywhere) TObjectPtr<USplineComponent> Spline;
 	TWeakObjectPtr<AActor> Target;
 	float AngleDeg =0.f; 
 	float PathT =0.f; 
-	bool bUseSpline = false;
+	TSharedPtr<const FOrbitPathTable> PathTable; // set by UseCircularSplinePath
 };
\ No newline at end of file
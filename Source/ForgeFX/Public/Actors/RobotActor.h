@@ -53,6 +53,11 @@ public:
 	UFUNCTION(BlueprintPure, Category="Robot|Test") bool IsPartCurrentlyDetached(FName PartName) const;
 	UFUNCTION(BlueprintCallable, Category="Robot|Test") bool DetachPartForTest(FName PartName);
 	UFUNCTION(BlueprintCallable, Category="Robot|Test") bool ReattachPartForTest(FName PartName);
+	// Sizes of the per-robot bookkeeping containers (soak runs watch these for growth)
+	void GetBookkeepingCounts(int32& OutPreviewMIDs, int32& OutPreviewMaterials, int32& OutLastDetachTimes, int32& OutSelected) const
+	{
+		OutPreviewMIDs = PreviewMIDs.Num(); OutPreviewMaterials = PreviewOriginalMaterials.Num(); OutLastDetachTimes = LastDetachTime.Num(); OutSelected = SelectedParts.Num();
+	}
 	UFUNCTION(BlueprintCallable, Category="Robot|Selection") void BatchDetachSelected();
 	UFUNCTION(BlueprintCallable, Category="Robot|Selection") void BatchReattachSelected();
 	UFUNCTION(BlueprintCallable, Category="Robot|Selection") void ClearSelection();
@@ -71,6 +76,7 @@ protected:
 	UFUNCTION() void OnInteractReleased();
 	UFUNCTION() void OnAssemblyPartDetached(FName PartName, ARobotPartActor* SpawnedActor);
 	UFUNCTION() void OnAssemblyPartReattached(FName PartName);
+	UFUNCTION() void OnAssemblyBuilt();
 
 	bool ComputeCursorWorldOnPlane(float PlaneZ, FVector& OutWorldPoint) const;
 	void TryBindToPlayerTrace();
@@ -80,7 +86,8 @@ private:
 	void SetStatusMessage(const FString& Msg);
 	void ShowPrompt(const FString& Msg, float DurationSeconds =2.f);
 	void ClearPrompt();
-	void SetCustomDepthAll(bool bEnable);
+	// Applies a hover target as a diff against the previous one (only the parts/components that changed are touched)
+	void SetHoverState(FName PartName, UStaticMeshComponent* OutlineComp, bool bOutlineWholeRobot);
 	void UpdateStatusText(bool bAttached);
 	void SpawnDetachVFXIfConfigured();
 	void UpdateReattachPreview();
@@ -89,6 +96,7 @@ private:
 	void ReattachAllDetached();
 	void PositionSocketInfoWidget(const FVector2D& ScreenPos);
 	void UpdateSnapMaterialParams();
+	void ClearSnapPreviewPart();
 
 	// Selection and UI enhancements
 	UPROPERTY(Transient) TArray<FName> SelectedParts;
@@ -159,9 +167,12 @@ protected:
 	UPROPERTY(Transient) TMap<TWeakObjectPtr<UStaticMeshComponent>, UMaterialInterface*> PreviewOriginalMaterials;
 	UPROPERTY(Transient) TMap<TWeakObjectPtr<UStaticMeshComponent>, UMaterialInstanceDynamic*> PreviewMIDs;
 	float PreviewAccumTime =0.f;
+	// Instanced-parent snap preview (custom data instead of material swap)
+	FName SnapPreviewPart = NAME_None; int32 SnapPreviewPushedState = INDEX_NONE;
 
 	// State
 	UPROPERTY(Transient) FName HoveredPartName = NAME_None;
+	TWeakObjectPtr<UStaticMeshComponent> HoverOutlineComp; bool bHoverOutlinesRobot = false;
 	UPROPERTY(Transient) bool bDragging = false;
 	UPROPERTY(Transient) bool bDraggingPart = false;
 	UPROPERTY(Transient) bool bShowcaseActive = false;
@@ -18,6 +18,11 @@ public:
 	// Setup this part when spawned from an assembly component
 	void InitializePart(FName InPartName, UStaticMesh* InMesh, const TArray<UMaterialInterface*>& InMaterials);
 
+	// Pool transitions (see URobotPartActorPool): parked actors are hidden, collision/physics off, PartName and owner cleared
+	void DeactivateToPool();
+	void ActivateFromPool(const FTransform& Transform);
+	bool IsParked() const { return bParked; }
+
 	// Optional physics toggle
 	UFUNCTION(BlueprintCallable, Category="Robot|Part") void EnablePhysics(bool bEnable);
 
@@ -34,4 +39,5 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components") TObjectPtr<UStaticMeshComponent> Mesh;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components") TObjectPtr<UHighlightComponent> Highlight;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Robot|Part") FName PartName;
+	bool bParked = false;
 };
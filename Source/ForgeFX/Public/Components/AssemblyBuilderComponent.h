@@ -4,14 +4,19 @@
 #include "Components/ActorComponent.h"
 #include "Data/RobotAssemblyConfig.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/AssemblySocketRegistry.h"
+#include "Components/AssemblyPartPicker.h"
 #include "AssemblyBuilderComponent.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRobotPartDetach, FName, PartName, ARobotPartActor*, SpawnedActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRobotPartReattach, FName, PartName);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnAssemblyReady);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAssemblyLoadProgress, float, Progress);
 
 class UMaterialInstanceDynamic;
 class ARobotPartActor;
 class UInstancedStaticMeshComponent;
+struct FStreamableHandle;
 
 USTRUCT()
 struct FORGEFX_API FDynamicMIDArray
@@ -20,6 +25,101 @@ struct FORGEFX_API FDynamicMIDArray
 	UPROPERTY(Transient) TArray<TObjectPtr<UMaterialInstanceDynamic>> MIDs;
 };
 
+USTRUCT()
+struct FORGEFX_API FPartBaseMaterials
+{
+	GENERATED_BODY()
+	UPROPERTY(Transient) TArray<TObjectPtr<UMaterialInterface>> Materials; // per slot, after MIDs were applied
+};
+
+// Custom data layout for the instanced path (material reads PerInstanceCustomData[N]) and for component parts in
+// EHighlightMode::PrimitiveCustomData (material reads CustomPrimitiveData[N])
+namespace ForgeFXInstanceData
+{
+	constexpr int32 HighlightAmount =0;
+	constexpr int32 SnapColorR =1;
+	constexpr int32 SnapColorG =2;
+	constexpr int32 SnapColorB =3;
+	constexpr int32 Selected =4;
+	constexpr int32 NumFloats =5;
+}
+
+// Per-part state bits stored in FAssemblyPartTable::Flags
+enum class EAssemblyPartFlags : uint8
+{
+	None				=0,
+	AffectsHighlight	=1 <<0,
+	Detachable			=1 <<1, // spec default
+	DetachOverride		=1 <<2, // DetachEnabled below wins over the spec default
+	DetachEnabled		=1 <<3,
+	Detached			=1 <<4,
+	Instanced			=1 <<5,
+	Hidden				=1 <<6, // instanced: collapsed to zero scale
+	Animating			=1 <<7, // in AnimatingParts (highlight not yet converged)
+};
+ENUM_CLASS_FLAGS(EAssemblyPartFlags)
+
+// Instanced path placement for one part (only meaningful when the Instanced flag is set)
+USTRUCT()
+struct FORGEFX_API FAssemblyPartInstance
+{
+	GENERATED_BODY()
+	int32 InstanceIndex = INDEX_NONE;
+	FTransform HomeLocal = FTransform::Identity; // relative to owner root, restored on reattach
+	FTransform CurrentLocal = FTransform::Identity; // current placement (free attach may move it)
+};
+
+// Reverse lookup for hit results: instance index -> part handle
+USTRUCT()
+struct FORGEFX_API FInstancedPartGroup
+{
+	GENERATED_BODY()
+	TArray<int32> PartByInstance;
+};
+
+/**
+ * Dense structure-of-arrays part table. A part handle is the index into every array and stays stable
+ * until the next BuildAssembly/ClearAssembly. Names resolve to handles through NameToIndex, component parts through
+ * ComponentToIndex (instanced parts share an ISMC and resolve per instance through the assembly's InstanceGroups).
+ */
+USTRUCT()
+struct FORGEFX_API FAssemblyPartTable
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient) TArray<FName> Names;
+	UPROPERTY(Transient) TArray<TObjectPtr<UStaticMeshComponent>> Components; // shared ISMC for instanced parts
+	UPROPERTY(Transient) TArray<TObjectPtr<ARobotPartActor>> DetachedActors;
+	UPROPERTY(Transient) TArray<FDynamicMIDArray> MIDs;
+	UPROPERTY(Transient) TArray<FPartBaseMaterials> BaseMaterials; // restore set for the hover material swap
+	TArray<EAssemblyPartFlags> Flags;
+	TArray<int32> ParentIndex; // spec parent handle, INDEX_NONE = owner root
+	TArray<FName> Socket; // spec parent socket
+	TArray<TWeakObjectPtr<USceneComponent>> ParentOverride; // set by free attach
+	TArray<FName> SocketOverride;
+	TArray<float> CurrentHighlight;
+	TArray<float> TargetHighlight;
+	TArray<FAssemblyPartInstance> Instances;
+	TMap<FName, int32> NameToIndex;
+	TMap<const UPrimitiveComponent*, int32> ComponentToIndex; // non-instanced parts only
+
+	int32 Num() const { return Names.Num(); }
+	bool IsValid(int32 Handle) const { return Names.IsValidIndex(Handle); }
+	int32 Find(FName Name) const { const int32* Found = NameToIndex.Find(Name); return Found ? *Found : INDEX_NONE; }
+	bool Has(int32 Handle, EAssemblyPartFlags Flag) const { return IsValid(Handle) && EnumHasAnyFlags(Flags[Handle], Flag); }
+	void Set(int32 Handle, EAssemblyPartFlags Flag, bool bOn) { if (bOn) EnumAddFlags(Flags[Handle], Flag); else EnumRemoveFlags(Flags[Handle], Flag); }
+	int32 Add(FName Name, UStaticMeshComponent* Comp, EAssemblyPartFlags InFlags, FName InSocket);
+	void Reset();
+};
+
+// One cached attach socket world transform per part; valid for one frame and one transform epoch
+struct FSocketWorldCacheEntry
+{
+	uint64 Frame = MAX_uint64;
+	uint32 Epoch =0;
+	FTransform World = FTransform::Identity;
+};
+
 UCLASS(ClassGroup=(ForgeFX), meta=(BlueprintSpawnableComponent))
 class FORGEFX_API UAssemblyBuilderComponent : public UActorComponent
 {
@@ -28,38 +128,95 @@ public:
 	UAssemblyBuilderComponent();
 
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void BuildAssembly();
+	// Async mode: meshes stream in without blocking; OnAssemblyReady fires when every mesh is in place
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Robot|Assembly") bool bAsyncMeshLoading = false;
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool IsAssemblyReady() const { return bAssemblyReady; }
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") float GetBuildProgress() const; // 0..1
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void ClearAssembly();
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
 
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void ApplyHighlightScalar(float Value); // all
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void ApplyHighlightScalarAll(float Value); // alias
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void ApplyHighlightScalarToParts(const TArray<FName>& PartNames, float Value);
+	// Single-part highlight target (other parts keep theirs); no-op for INDEX_NONE
+	void SetPartHighlightTarget(int32 Handle, float Value);
+	// Custom depth on every assembled part component (one ISMC per group); only components whose flag differs are touched
+	void SetRenderCustomDepthAll(bool bEnable);
 
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") bool SetPartVisibility(FName PartName, bool bVisible);
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool GetPartWorldLocation(FName PartName, FVector& OutLocation) const;
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") UStaticMeshComponent* GetPartByName(FName PartName) const;
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool FindPartNameByComponent(const UPrimitiveComponent* Comp, FName& OutName) const;
+	// Resolves hits on shared ISMCs via the hit item (instance index); falls back to FindPartNameByComponent
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool FindPartNameByHit(const UPrimitiveComponent* Comp, int32 HitItem, FName& OutName) const;
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool GetPartWorldTransform(FName PartName, FTransform& OutTransform) const;
 
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") bool DetachPart(FName PartName, ARobotPartActor*& OutActor);
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") bool ReattachPart(FName PartName, ARobotPartActor* PartActor);
-	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool IsPartDetached(FName PartName) const { return DetachedParts.Contains(PartName); }
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool IsPartDetached(FName PartName) const { return Parts.Has(Parts.Find(PartName), EAssemblyPartFlags::Detached); }
+	// O(1) lookup of the actor standing in for one of this assembly's detached parts (never another robot's)
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") ARobotPartActor* GetDetachedActor(FName PartName) const;
+	// ReattachPart using the registered detached actor
+	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") bool ReattachDetachedPart(FName PartName);
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool GetPartSpec(FName PartName, FRobotPartSpec& OutSpec) const;
+	// C++ fast path: O(1) via the config's part index, no copy
+	const FRobotPartSpec* FindPartSpec(FName PartName) const { return AssemblyConfig ? AssemblyConfig->FindPartSpec(PartName) : nullptr; }
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool GetAttachParentAndSocket(FName PartName, USceneComponent*& OutParent, FName& OutSocket) const;
+	// World transform of the socket this part snaps back to (works for both component and instanced parents)
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool GetAttachSocketWorldTransform(FName PartName, FTransform& OutSocketWorld) const;
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void SetDetachEnabledForParts(const TArray<FName>& PartNames, bool bEnabled);
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") void SetDetachEnabledForAll(bool bEnabled);
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool IsDetachEnabled(FName PartName) const;
 	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") bool AttachDetachedPartTo(FName PartName, ARobotPartActor* PartActor, USceneComponent* NewParent, FName SocketName);
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool FindNearestAttachTarget(const FVector& AtWorldLocation, USceneComponent*& OutParent, FName& OutSocket, float& OutDistance, FName ExcludePartName = NAME_None) const;
+	// Grid-accelerated query over the cached socket registry; Radius <=0 means unbounded. Fails if nothing is within Radius.
+	bool FindNearestAttachTargetInRadius(const FVector& AtWorldLocation, float Radius, TConstArrayView<FName> ExcludePartNames, USceneComponent*& OutParent, FName& OutSocket, float& OutDistance) const;
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") void GetAllAttachTargets(TArray<USceneComponent*>& OutTargets) const;
 	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool IsDetachable(FName PartName) const;
 	UFUNCTION(Exec) void RebuildAssembly();
 	UFUNCTION(Exec) void DumpState();
+	// Hide state is applied once on detach; this re-checks detached parts and only touches render state that drifted
+	// (e.g. a Blueprint re-enabled visibility). Returns the number of parts repaired.
+	UFUNCTION(BlueprintCallable, Category="Robot|Assembly") int32 VerifyDetachedHidden();
+
+	// Handle-based access for C++ callers that resolve a name once (handles are invalidated by BuildAssembly/ClearAssembly)
+	int32 FindPartHandle(FName PartName) const { return Parts.Find(PartName); }
+	int32 GetNumParts() const { return Parts.Num(); }
+	FName GetPartNameByHandle(int32 Handle) const { return Parts.IsValid(Handle) ? Parts.Names[Handle] : NAME_None; }
+	UStaticMeshComponent* GetPartComponentByHandle(int32 Handle) const { return Parts.IsValid(Handle) ? Parts.Components[Handle].Get() : nullptr; }
+	bool IsPartDetachedByHandle(int32 Handle) const { return Parts.Has(Handle, EAssemblyPartFlags::Detached); }
+	int32 GetPartInstanceIndexByHandle(int32 Handle) const { return Parts.Has(Handle, EAssemblyPartFlags::Instanced) ? Parts.Instances[Handle].InstanceIndex : INDEX_NONE; }
 
-	// Optional: use Instanced Static Mesh Components for parts (coexists with current system). One ISMC per part, one instance.
+	// Optional: parts carry no collision and are hit-tested by the assembly's own ray picker (mesh bounds, then LOD0
+	// triangles) instead of physics bodies. Hover traces query it through URobotAssemblySubsystem.
+	UPROPERTY(EditAnywhere, Category="Robot|Assembly") bool bUsePartPicker = false;
+	// Nearest assembled, visible part on Start->End (bUsePartPicker only); OutHandle is a part handle
+	bool PickPart(const FVector& Start, const FVector& End, int32& OutHandle, FVector& OutLocation, float& OutDistance) const;
+
+	// Optional: use Instanced Static Mesh Components for parts. Parts sharing a mesh share one ISMC; highlight,
+	// snap color and selection go through per-instance custom data (see ForgeFXInstanceData) instead of MIDs.
+	// Hierarchy is baked at build time: instances do not follow a parent instance that is later moved.
 	UPROPERTY(EditAnywhere, Category="Robot|Assembly") bool bUseInstancedComponents = false;
+	// Cell size of the attach point grid; roughly the typical snap search radius works best
+	UPROPERTY(EditAnywhere, Category="Robot|Assembly", meta=(ClampMin="1")) float SocketGridCellSize =50.f;
+	UFUNCTION(BlueprintPure, Category="Robot|Assembly") bool IsPartInstanced(FName PartName) const { return Parts.Has(Parts.Find(PartName), EAssemblyPartFlags::Instanced); }
+	// Component parts use custom primitive data instead of MIDs and the hover material swap
+	bool UsesPrimitiveCustomData() const { return AssemblyConfig && AssemblyConfig->HighlightMode == EHighlightMode::PrimitiveCustomData; }
+	// Instanced parts, or every part in PrimitiveCustomData mode; false when the part has no custom data to drive
+	UFUNCTION(BlueprintCallable, Category="Robot|Highlight") bool SetPartSelected(FName PartName, bool bSelected);
+	UFUNCTION(BlueprintCallable, Category="Robot|Highlight") bool SetPartSnapColor(FName PartName, FLinearColor Color);
+
+	// Detached part actors are recycled through the world's URobotPartActorPool instead of spawn/destroy
+	UPROPERTY(EditAnywhere, Category="Robot|Assembly") bool bUsePartActorPool = true;
+	// Idle actors parked per detached actor class once the assembly is ready (0 = spawn lazily)
+	UPROPERTY(EditAnywhere, Category="Robot|Assembly", meta=(ClampMin="0", EditCondition="bUsePartActorPool")) int32 PartActorPrewarmCount =0;
 
 	// Optional: strong hover override via material swap
 	UPROPERTY(EditAnywhere, Category="Robot|Highlight") bool bUseHoverHighlightMaterial = true;
 	UPROPERTY(EditAnywhere, Category="Robot|Highlight") TObjectPtr<UMaterialInterface> HoverHighlightMaterial;
+	// Draw HoverHighlightMaterial as the hovered component's overlay material: base materials stay untouched and
+	// hover costs one render state update. Off = replace every material slot (restored from the build-time cache).
+	UPROPERTY(EditAnywhere, Category="Robot|Highlight", meta=(EditCondition="bUseHoverHighlightMaterial")) bool bHoverOverlayMaterial = true;
 	UFUNCTION(BlueprintCallable, Category="Robot|Highlight") void ApplyHoverOverride(UPrimitiveComponent* HoveredComp);
 	UFUNCTION(BlueprintCallable, Category="Robot|Highlight") void ClearHoverOverride();
 
@@ -67,30 +224,68 @@ public:
 
 	// Highlight smoothing speed (units per second toward target value)
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Robot|Highlight") float HighlightInterpSpeed =12.f;
+	// A part stops animating (and snaps to its target) once within this distance
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Robot|Highlight", meta=(ClampMin="0")) float HighlightSettleTolerance =0.001f;
+	// Number of parts whose highlight is still interpolating (the assembly leaves the batch while this is 0)
+	int32 GetNumAnimatingParts() const { return AnimatingParts.Num(); }
+
+	// Batched update (URobotAssemblySubsystem): Step is pure math on this assembly's table and may run on a worker;
+	// Commit pushes the changed values on the game thread and returns false once nothing is animating
+	void StepHighlight(float DeltaTime);
+	bool CommitHighlight();
 
 	UPROPERTY(BlueprintAssignable, Category="Robot|Events") FOnRobotPartDetach OnRobotPartDetach;
 	UPROPERTY(BlueprintAssignable, Category="Robot|Events") FOnRobotPartReattach OnRobotPartReattach;
+	UPROPERTY(BlueprintAssignable, Category="Robot|Events") FOnAssemblyReady OnAssemblyReady;
+	UPROPERTY(BlueprintAssignable, Category="Robot|Events") FOnAssemblyLoadProgress OnAssemblyLoadProgress;
 
 protected:
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	bool IsDetachableNow(FName PartName) const;
+	bool IsDetachableNow(int32 Handle) const;
 
 private:
-	UPROPERTY(Transient) TMap<FName, TObjectPtr<UStaticMeshComponent>> NameToComponent;
-	UPROPERTY(Transient) TMap<TObjectPtr<UStaticMeshComponent>, FName> ComponentToName;
-	UPROPERTY(Transient) TMap<FName, bool> PartAffectsHighlight;
-	UPROPERTY(Transient) TMap<TObjectPtr<UStaticMeshComponent>, FDynamicMIDArray> DynamicMIDs;
-	UPROPERTY(Transient) TMap<FName, TObjectPtr<ARobotPartActor>> DetachedParts;
-	UPROPERTY(Transient) TMap<FName, bool> DetachEnabledOverride;
-	UPROPERTY(Transient) TMap<FName, TWeakObjectPtr<USceneComponent>> ParentOverride;
-	UPROPERTY(Transient) TMap<FName, FName> SocketOverride;
-	// Highlight interpolation maps
-	TMap<TWeakObjectPtr<UStaticMeshComponent>, float> CurrentHighlight;
-	TMap<TWeakObjectPtr<UStaticMeshComponent>, float> TargetHighlight;
-
-	// Hover material override original cache
+	UPROPERTY(Transient) FAssemblyPartTable Parts;
+	UPROPERTY(Transient) TMap<TObjectPtr<UInstancedStaticMeshComponent>, FInstancedPartGroup> InstanceGroups;
+	TArray<int32> AnimatingParts; // handles with CurrentHighlight != TargetHighlight
+	TArray<int32> HighlightDirty; // handles changed by the last StepHighlight, pushed by CommitHighlight
+	mutable FAssemblySocketRegistry SocketRegistry; // refreshed on query, marked dirty by transform updates
+	mutable FAssemblyPartPicker PartPicker; // same dirty tracking as the socket registry; empty unless bUsePartPicker
+	mutable TArray<FSocketWorldCacheEntry> SocketWorldCache; // by handle (the attach socket is fixed per part)
+	mutable uint32 TransformEpoch =0; // bumped on any part/instance transform change
+	TSharedPtr<FStreamableHandle> MeshLoadHandle; // in-flight async mesh request
+	TArray<int32> PendingMeshParts; // component parts still waiting on their mesh
+	bool bAssemblyReady = false;
+
+	// Hover material override state; restore data is reused across hovers, nothing is allocated per hover
 	TWeakObjectPtr<UStaticMeshComponent> CurrentHoverComp;
-	TMap<TWeakObjectPtr<UStaticMeshComponent>, TArray<TObjectPtr<UMaterialInterface>>> SavedMaterials;
+	bool bHoverOverlayApplied = false;
+	int32 HoverPartHandle = INDEX_NONE; // swap restores Parts.BaseMaterials of this part...
+	UPROPERTY(Transient) TArray<TObjectPtr<UMaterialInterface>> HoverSavedMaterials; // ...or these (detached part actors)
+	UPROPERTY(Transient) TObjectPtr<UMaterialInterface> HoverSavedOverlay;
 
-	void EnsureDynamicMIDs(UStaticMeshComponent* Comp);
+	void EnsureDynamicMIDs(int32 Handle);
+	void CacheBaseMaterials(int32 Handle);
+	bool DrivesHighlightAmount() const { return AssemblyConfig && AssemblyConfig->HighlightMode != EHighlightMode::CustomDepthStencil; }
+	void PushPartHighlight(int32 Handle, float Value);
+	void SetHighlightTarget(int32 Handle, float Value);
+	void ApplyInstanceTransform(int32 Handle) const;
+	UInstancedStaticMeshComponent* GetInstancedComponent(int32 Handle) const;
+	USceneComponent* ResolveSpecParent(int32 Handle) const;
+	FTransform GetOwnerRootTransform() const;
+	void OnPartTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 Handle);
+	void RefreshSocketRegistry() const;
+	void RebuildSocketRegistry();
+	void RebuildPartPicker();
+	FTransform ComputePartWorld(int32 Handle, const FTransform& RootWorld) const;
+	ECollisionEnabled::Type GetAssembledCollision() const { return bUsePartPicker ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryOnly; }
+	void BuildParts(bool bDeferUnloadedMeshes);
+	void FinishAssembly();
+	void ReleasePartActor(ARobotPartActor* PartActor) const;
+	void ReleaseStatCounts() const; // takes this assembly's MIDs and detached actors off the STATGROUP_ForgeFX counters
+	// Assembled render/collision state for a component part; detached descendants stay hidden
+	void ShowComponentPart(UStaticMeshComponent* Comp) const;
+	void PrewarmPartActors() const;
+	void SwapInLoadedMeshes();
+	void OnPartMeshLoadUpdate(TSharedRef<FStreamableHandle> Handle);
+	void OnPartMeshesLoaded();
 };
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ * Ray picking for assembly parts without physics bodies. Each part keeps its mesh bounds as a local-space box
+ * (an OBB once placed in the world); rays are moved into part space and slab-tested with vector math, and only the
+ * nearest boxes are refined against the mesh's LOD0 triangles. A ray that misses the union of the part boxes is rejected
+ * before any per-part work, so many assemblies can be queried per trace. Triangle data is copied once per mesh and shared
+ * by the parts using it; meshes without CPU-readable render data fall back to the box hit.
+ */
+class FORGEFX_API FAssemblyPartPicker
+{
+public:
+	void Reset();
+	// Parts must be added in handle order (0..N-1); entries start dirty
+	void AddPart(int32 Part, const UStaticMesh* Mesh);
+
+	void MarkPartDirty(int32 Part) { if (PartDirty.IsValidIndex(Part) && !PartDirty[Part]) { PartDirty[Part] = true; ++NumDirty; } }
+	void MarkAllDirty() { for (int32 i=0; i<PartDirty.Num(); ++i) MarkPartDirty(i); }
+	bool HasDirty() const { return NumDirty >0; }
+	// Re-reads the world transforms of dirty parts only (and the combined bounds, if anything was dirty)
+	void Refresh(TFunctionRef<FTransform(int32 Part)> GetPartWorld);
+	const FBox& GetWorldBounds() const { return WorldBounds; }
+
+	// Nearest part hit by the segment Start->End among parts accepted by IsPickable. Returns the part or INDEX_NONE.
+	int32 Raycast(const FVector& Start, const FVector& End, TFunctionRef<bool(int32 Part)> IsPickable, FVector& OutLocation, float& OutDistance) const;
+
+	int32 Num() const { return LocalMin.Num(); }
+	bool HasTriangles(int32 Part) const { return PartMesh.IsValidIndex(Part) && PartMesh[Part].IsValid() && PartMesh[Part]->Indices.Num() >0; }
+
+private:
+	struct FPickMesh
+	{
+		TArray<FVector3f> Positions;
+		TArray<uint32> Indices;
+	};
+	TSharedPtr<const FPickMesh> GetPickMesh(const UStaticMesh* Mesh);
+	// Entry parameter along the local ray, or false if the box is missed within [0, 1]
+	bool SlabTest(int32 Part, const FVector3f& Origin, const FVector3f& Delta, float& OutT) const;
+	bool TriangleTest(const FPickMesh& Mesh, const FVector3f& Origin, const FVector3f& Delta, float MaxT, float& OutT) const;
+
+	// Per part (structure-of-arrays)
+	TArray<FVector3f> LocalMin, LocalMax; // mesh bounds in part space; empty box (Min > Max) = nothing to pick
+	TArray<FTransform> PartWorld;
+	TArray<FBox> PartWorldBox; // world AABB of each placed box, invalid when there is nothing to pick
+	TArray<TSharedPtr<const FPickMesh>> PartMesh;
+	TBitArray<> PartDirty;
+	int32 NumDirty =0;
+	FBox WorldBounds = FBox(ForceInit); // union of PartWorldBox
+
+	TMap<TWeakObjectPtr<const UStaticMesh>, TSharedPtr<const FPickMesh>> MeshCache;
+};
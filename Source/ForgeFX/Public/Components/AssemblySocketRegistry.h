@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ * Cached attach points of an assembly: one entry per part origin plus one per mesh socket, stored as flat arrays and
+ * bucketed in a uniform hash grid. Entries of a part are contiguous, so a moved part only rewrites its own slots
+ * (MarkPartDirty + Refresh). Queries never allocate and never touch components.
+ */
+class FORGEFX_API FAssemblySocketRegistry
+{
+public:
+	void Reset(float InCellSize);
+	// Parts must be added in handle order (0..N-1); entries start dirty
+	void AddPart(int32 Part, const UStaticMesh* Mesh);
+
+	void MarkPartDirty(int32 Part) { if (PartDirty.IsValidIndex(Part) && !PartDirty[Part]) { PartDirty[Part] = true; ++NumDirty; } }
+	void MarkAllDirty() { for (int32 i=0; i<PartDirty.Num(); ++i) MarkPartDirty(i); }
+	bool HasDirty() const { return NumDirty >0; }
+	// Recomputes world positions of dirty parts only; GetPartWorld returns the part's current world transform
+	void Refresh(TFunctionRef<FTransform(int32 Part)> GetPartWorld);
+
+	// Nearest entry to At whose part is not in ExcludeParts. Radius <=0 searches everything. Returns the entry index or INDEX_NONE.
+	int32 FindNearest(const FVector& At, float Radius, TConstArrayView<int32> ExcludeParts, float& OutDistance) const;
+
+	int32 Num() const { return EntryPart.Num(); }
+	int32 GetEntryPart(int32 Entry) const { return EntryPart[Entry]; }
+	FName GetEntrySocket(int32 Entry) const { return EntrySocket[Entry]; } // NAME_None = part origin
+	const FVector& GetEntryWorld(int32 Entry) const { return EntryWorld[Entry]; }
+
+private:
+	FIntVector CellOf(const FVector& P) const { return FIntVector(FMath::FloorToInt32(P.X * InvCellSize), FMath::FloorToInt32(P.Y * InvCellSize), FMath::FloorToInt32(P.Z * InvCellSize)); }
+	void MoveToCell(int32 Entry, const FIntVector& NewCell);
+	bool IsExcluded(int32 Entry, TConstArrayView<int32> ExcludeParts) const { return ExcludeParts.Contains(EntryPart[Entry]); }
+
+	// Entry arrays (structure-of-arrays)
+	TArray<int32> EntryPart;
+	TArray<FName> EntrySocket;
+	TArray<FVector> EntryLocal; // socket location in part space
+	TArray<FVector> EntryWorld;
+	TArray<FIntVector> EntryCell;
+	TArray<bool> EntryInGrid;
+
+	// Per part: contiguous entry range and dirty bit
+	TArray<int32> PartFirstEntry;
+	TArray<int32> PartNumEntries;
+	TBitArray<> PartDirty;
+	int32 NumDirty =0;
+
+	TMap<FIntVector, TArray<int32, TInlineAllocator<8>>> Cells;
+	float CellSize =50.f;
+	float InvCellSize =1.f /50.f;
+};
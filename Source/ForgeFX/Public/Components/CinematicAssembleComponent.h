@@ -1,21 +1,13 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Data/CinematicTimeline.h"
 #include "CinematicAssembleComponent.generated.h"
 class UAssemblyBuilderComponent; class ARobotPartActor;
 
 UENUM(BlueprintType)
 enum class ECinematicPhase : uint8 { None, Scatter, Return };
 
-USTRUCT()
-struct FCinePart
-{
-	GENERATED_BODY()
-	UPROPERTY() TObjectPtr<ARobotPartActor> Actor;
-	UPROPERTY() FTransform TargetSocketWorld;
-	UPROPERTY() FVector ScatterDir;
-};
-
 UCLASS(ClassGroup=(ForgeFX), meta=(BlueprintSpawnableComponent))
 class FORGEFX_API UCinematicAssembleComponent : public UActorComponent
 {
@@ -23,14 +15,36 @@ class FORGEFX_API UCinematicAssembleComponent : public UActorComponent
 public:
 	UCinematicAssembleComponent();
 	UFUNCTION(BlueprintCallable, Category="Cinematic") void TriggerAssemble(FVector NewLocation);
-protected:
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// Plays this timeline on the next trigger (null = default scatter/return)
+	UFUNCTION(BlueprintCallable, Category="Cinematic") void SetTimeline(UCinematicTimeline* InTimeline) { Timeline = InTimeline; }
+	UFUNCTION(BlueprintPure, Category="Cinematic") bool IsCinematicActive() const { return Phase != ECinematicPhase::None; }
+	// Batched update (URobotAssemblySubsystem): Step advances time and computes part locations without touching
+	// actors (worker safe); Commit moves the actors and handles phase changes, returning false once finished
+	void StepCinematic(float DeltaTime);
+	bool CommitCinematic();
 private:
-	ECinematicPhase Phase = ECinematicPhase::None; float Elapsed =0.f; FVector BaseTarget = FVector::ZeroVector; TArray<FCinePart> Parts;
-	UPROPERTY(EditAnywhere, Category="Cinematic") float ScatterDuration =0.75f;
-	UPROPERTY(EditAnywhere, Category="Cinematic") float ReturnDuration =1.5f;
-	UPROPERTY(EditAnywhere, Category="Cinematic") float ScatterDistance =300.f;
-	UPROPERTY(EditAnywhere, Category="Cinematic") float EasePower =2.f;
+	ECinematicPhase Phase = ECinematicPhase::None; float Elapsed =0.f; FVector BaseTarget = FVector::ZeroVector;
+	FVector RobotMove = FVector::ZeroVector; // destination - robot location, updated when the robot jumps
+	float TotalDuration =0.f;
+	TSharedPtr<const FCinematicTimelineSampler> ActiveSampler; // kept alive for the whole flight even if the asset is edited
+	// Per part, structure-of-arrays; filled once in BuildPartList and read by workers in StepCinematic
+	UPROPERTY(Transient) TArray<TObjectPtr<ARobotPartActor>> PartActors;
+	TArray<FName> PartNames; // what each actor was detached as; the assembly registry decides whether it is still ours
+	TArray<FVector> HomeLocations; // attach socket at trigger time
+	TArray<FVector> ScatterDirs;
+	TArray<int32> PartTracks; // track index in ActiveSampler
+	TArray<float> PartStartTimes; // stagger
+	TArray<FVector> PendingLocations; // written by StepCinematic, applied by CommitCinematic
+	TBitArray<> RestoreOverlaps; // parts whose overlap events were switched off for the flight
+	// Choreography; when unset the two-phase scatter/return below is used
+	UPROPERTY(EditAnywhere, Category="Cinematic") TObjectPtr<UCinematicTimeline> Timeline;
+	UPROPERTY(EditAnywhere, Category="Cinematic", meta=(EditCondition="Timeline==nullptr")) float ScatterDuration =0.75f;
+	UPROPERTY(EditAnywhere, Category="Cinematic", meta=(EditCondition="Timeline==nullptr")) float ReturnDuration =1.5f;
+	UPROPERTY(EditAnywhere, Category="Cinematic", meta=(EditCondition="Timeline==nullptr")) float ScatterDistance =300.f;
+	UPROPERTY(EditAnywhere, Category="Cinematic", meta=(EditCondition="Timeline==nullptr")) float EasePower =2.f;
 	UAssemblyBuilderComponent* GetAssembly() const;
 	void BuildPartList();
+	void ResetPartList();
+	void RestoreOverlap(int32 Index);
+	void DropReleasedParts(const UAssemblyBuilderComponent& Assembly);
 };
\ No newline at end of file
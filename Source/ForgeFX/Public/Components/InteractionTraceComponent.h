@@ -3,8 +3,11 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Interfaces/Interactable.h"
+#include "WorldCollision.h"
 #include "InteractionTraceComponent.generated.h"
 
+class UCameraComponent;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHoverComponentChanged, UPrimitiveComponent*, HitComponent, AActor*, HitActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteractPressedSig, UPrimitiveComponent*, HitComponent, AActor*, HitActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteractAltPressedSig, UPrimitiveComponent*, HitComponent, AActor*, HitActor);
@@ -25,6 +28,21 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction")
 	float TraceDistance =500.f;
 
+	// Issue the trace through the async scene query queue and apply its result next frame (one frame hover latency)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction|Performance")
+	bool bAsyncTrace = false;
+
+	// Skip the trace while the view has not moved more than the epsilons below
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction|Performance")
+	bool bThrottleWhenStill = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction|Performance", meta=(EditCondition="bThrottleWhenStill"))
+	float ThrottleMoveEpsilon =0.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction|Performance", meta=(EditCondition="bThrottleWhenStill"))
+	float ThrottleAngleEpsilonDeg =0.1f;
+	// Trace anyway after this many skipped frames so things moving under a still view are picked up
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction|Performance", meta=(EditCondition="bThrottleWhenStill", ClampMin="0"))
+	int32 ThrottleMaxSkippedFrames =6;
+
 	// Optional debug drawing
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Interaction|Debug")
 	bool bDrawDebugTrace = false;
@@ -44,6 +62,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Interaction")
 	void InteractAltPressed();
 
+	// Re-resolve the view camera (cached at BeginPlay); call after adding/swapping cameras on the owner
+	UFUNCTION(BlueprintCallable, Category="Interaction")
+	void RefreshCachedCamera();
+
+	// Hit item of the current hover (instance index for instanced components, INDEX_NONE otherwise)
+	UFUNCTION(BlueprintPure, Category="Interaction")
+	int32 GetHoveredItem() const { return CurrentHitItem; }
+
 	UPROPERTY(BlueprintAssignable, Category="Interaction")
 	FOnHoverComponentChanged OnHoverComponentChanged;
 	UPROPERTY(BlueprintAssignable, Category="Interaction")
@@ -56,6 +82,15 @@ public:
 private:
 	TWeakInterfacePtr<IInteractable> CurrentHover;
 	TWeakObjectPtr<UPrimitiveComponent> CurrentHitComp;
+	int32 CurrentHitItem = INDEX_NONE;
 	bool bInteractHeld = false;
-	void UpdateHover(const TWeakInterfacePtr<IInteractable>& NewHover, UPrimitiveComponent* NewComp, AActor* HitActor);
+	void UpdateHover(const TWeakInterfacePtr<IInteractable>& NewHover, UPrimitiveComponent* NewComp, AActor* HitActor, int32 HitItem);
+	void ApplyTraceHit(const FHitResult& Hit, const FVector& Start, const FVector& End);
+
+	TWeakObjectPtr<UCameraComponent> CachedCamera;
+	FTraceHandle PendingTrace;
+	FVector PendingStart = FVector::ZeroVector, PendingEnd = FVector::ZeroVector;
+	FVector LastTraceStart = FVector::ZeroVector, LastTraceDir = FVector::ZeroVector;
+	int32 SkippedFrames =0;
+	bool bHasTraced = false;
 };
@@ -15,8 +15,8 @@ public:
 	UFUNCTION(BlueprintPure, Category="PartInteraction") bool IsDraggingPart() const { return bDraggingPart; }
 	UFUNCTION(BlueprintCallable, Category="PartInteraction") void ForceDropHeldPart(bool bTrySnap);
 
-	// Handle an interact press from RobotActor
-	bool HandleInteractPressed(UPrimitiveComponent* HitComponent, AActor* HitActor, bool bAllowFreeAttach, float AttachPosTolerance, float AttachAngleToleranceDeg, float PartGrabMinDistance, float PartGrabMaxDistance);
+	// Handle an interact press from RobotActor; HitItem is the trace hit item (instance index on shared ISMCs)
+	bool HandleInteractPressed(UPrimitiveComponent* HitComponent, AActor* HitActor, bool bAllowFreeAttach, float AttachPosTolerance, float AttachAngleToleranceDeg, float PartGrabMinDistance, float PartGrabMaxDistance, int32 HitItem = INDEX_NONE);
 	void HandleInteractReleased(bool bHoldToDragMode, bool bAllowFreeAttach);
 
 	// Per-frame update
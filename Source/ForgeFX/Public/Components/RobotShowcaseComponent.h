@@ -4,6 +4,13 @@
 #include "RobotShowcaseComponent.generated.h"
 class UAssemblyBuilderComponent; class AOrbitCameraRig; class ARobotPartActor; class ARobotActor;
 
+// One scheduled showcase step; Part is unused for the final reattach
+struct FShowcaseAction
+{
+	enum class EType : uint8 { Detach, ReattachAll };
+	int64 Tick =0; EType Type = EType::Detach; FName Part;
+};
+
 UCLASS(ClassGroup=(ForgeFX), meta=(BlueprintSpawnableComponent))
 class FORGEFX_API URobotShowcaseComponent : public UActorComponent
 {
@@ -13,15 +20,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Showcase") void StartShowcase();
 	UFUNCTION(BlueprintCallable, Category="Showcase") void StopShowcase();
 	UFUNCTION(BlueprintPure, Category="Showcase") bool IsShowcaseActive() const { return bActive; }
-protected:
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// Called by URobotAssemblySubsystem each frame while active; returns false once the showcase has stopped.
+	// Time advances in whole FixedStepHz ticks and every action due by the current tick runs, so a hitch
+	// replays the missed actions in order instead of slipping the schedule.
+	bool AdvanceShowcase(float DeltaTime);
+	int64 GetShowcaseTick() const { return Tick; }
+	int32 GetNumPendingActions() const { return Schedule.Num() - NextAction; }
 private:
-	void StepShowcase();
+	void RunAction(const FShowcaseAction& Action);
 	UAssemblyBuilderComponent* GetAssembly() const;
 private:
-	bool bActive = false; int32 Index = -1; TArray<FName> Order; float Elapsed =0.f;
+	bool bActive = false; TArray<FShowcaseAction> Schedule; int32 NextAction =0; int64 Tick =0; double Accumulator =0.0;
 	UPROPERTY(EditAnywhere, Category="Showcase") float DetachInterval =0.6f;
 	UPROPERTY(EditAnywhere, Category="Showcase") float InitialDelay =0.5f;
+	// Schedule resolution; action times are rounded to this grid
+	UPROPERTY(EditAnywhere, Category="Showcase", meta=(ClampMin="1")) int32 FixedStepHz =120;
 	UPROPERTY(EditAnywhere, Category="Showcase") float OrbitRadius =650.f;
 	UPROPERTY(EditAnywhere, Category="Showcase") float OrbitHeight =150.f;
 	UPROPERTY(EditAnywhere, Category="Showcase") float OrbitSpeedDeg =30.f;
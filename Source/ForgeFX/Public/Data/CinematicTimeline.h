@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Curves/CurveFloat.h"
+#include "CinematicTimeline.generated.h"
+
+UENUM(BlueprintType)
+enum class ECinematicEase : uint8
+{
+	Linear,
+	EaseIn,
+	EaseOut,
+	EaseInOut,
+	Step		UMETA(ToolTip = "Hold the previous key, jump at the end of the segment"),
+	Curve		UMETA(ToolTip = "Sample EaseCurve (0..1 -> 0..1)")
+};
+
+// One pose of a part, relative to its attach socket at trigger time
+USTRUCT(BlueprintType)
+struct FORGEFX_API FCinematicKey
+{
+	GENERATED_BODY()
+
+	// Seconds from the start of the track (after Delay and stagger)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) float Time =0.f;
+	// World-space offset from the socket
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) FVector Offset = FVector::ZeroVector;
+	// Distance along the part's random scatter direction
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) float ScatterAmount =0.f;
+	// 0 = relative to where the robot started, 1 = relative to the robot's destination
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0", ClampMax="1")) float FollowRobot =0.f;
+	// Easing of the segment that ends at this key (ignored on the first key)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) ECinematicEase Ease = ECinematicEase::Linear;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(EditCondition="Ease==ECinematicEase::EaseIn||Ease==ECinematicEase::EaseOut||Ease==ECinematicEase::EaseInOut")) float EaseExponent =2.f;
+	UPROPERTY(EditAnywhere, meta=(EditCondition="Ease==ECinematicEase::Curve")) FRuntimeFloatCurve EaseCurve;
+};
+
+USTRUCT(BlueprintType)
+struct FORGEFX_API FCinematicTrack
+{
+	GENERATED_BODY()
+
+	// Part this track drives; None = default track for every part without its own
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) FName PartName;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) float Delay =0.f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly) TArray<FCinematicKey> Keys;
+};
+
+/**
+ * Compiled form of a timeline: keys flattened per track and every non-linear ease baked into a lookup table, so
+ * evaluation is plain arithmetic (no UObject or rich curve access, no allocation) and safe on worker threads.
+ */
+struct FORGEFX_API FCinematicTimelineSampler
+{
+	// Per track
+	TArray<int32> TrackFirstKey, TrackNumKeys;
+	TArray<float> TrackDelay;
+	TMap<FName, int32> TrackByPart;
+	int32 DefaultTrack = INDEX_NONE;
+
+	// Per key (structure-of-arrays, sorted by time within a track)
+	TArray<float> KeyTime;
+	TArray<FVector> KeyOffset;
+	TArray<float> KeyScatter, KeyFollow;
+	TArray<int32> KeyEaseTable; // first sample in EaseTables, INDEX_NONE = linear
+
+	TArray<float> EaseTables; // TableResolution +1 samples per table
+	int32 TableResolution =64;
+
+	float StaggerPerPart =0.f;
+	float RobotMoveTime =0.f;
+	float Duration =0.f; // longest track incl. delay, before stagger
+
+	void Compile(const TArray<FCinematicTrack>& Tracks, int32 Resolution);
+	// Default two-phase flight: scatter out linearly, then ease back onto the moved robot
+	static FCinematicTimelineSampler MakeScatterReturn(float ScatterDuration, float ReturnDuration, float ScatterDistance, float EasePower);
+
+	// Track for a part (its own, else the default); INDEX_NONE if neither exists
+	int32 FindTrack(FName PartName) const;
+	float GetTotalDuration(int32 NumParts) const { return Duration + StaggerPerPart * FMath::Max(NumParts -1,0); }
+	FVector Evaluate(int32 Track, float Time, const FVector& Home, const FVector& ScatterDir, const FVector& RobotMove) const;
+
+private:
+	int32 BakeEase(const FCinematicKey& Key);
+	float SampleEase(int32 Table, float Alpha) const;
+};
+
+UCLASS(BlueprintType)
+class FORGEFX_API UCinematicTimeline : public UDataAsset
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Cinematic")
+	TArray<FCinematicTrack> Tracks;
+
+	// Extra start delay per part, in assembly order
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Cinematic")
+	float StaggerPerPart =0.f;
+
+	// When the robot jumps to the cinematic's target location
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Cinematic")
+	float RobotMoveTime =0.75f;
+
+	// Samples per baked ease table
+	UPROPERTY(EditAnywhere, Category="Cinematic", AdvancedDisplay, meta=(ClampMin="4", ClampMax="1024"))
+	int32 CurveTableResolution =64;
+
+	// Compiled on first use; shared by every component playing this asset and dropped on edit
+	TSharedRef<const FCinematicTimelineSampler> GetSampler() const;
+	void InvalidateSampler() const { Sampler.Reset(); }
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	mutable TSharedPtr<const FCinematicTimelineSampler> Sampler;
+};
@@ -11,11 +11,13 @@ UENUM(BlueprintType)
 enum class EHighlightMode : uint8
 {
 	MaterialParameter	UMETA(DisplayName = "Material Parameter"),
-	CustomDepthStencil	UMETA(DisplayName = "Custom Depth / Stencil")
+	CustomDepthStencil	UMETA(DisplayName = "Custom Depth / Stencil"),
+	PrimitiveCustomData	UMETA(DisplayName = "Primitive Custom Data", ToolTip = "Custom primitive data slots (ForgeFXInstanceData layout); no per-part material instances")
 };
 
 // Forward declare custom detachable part actor class
 class ARobotPartActor;
+class UMaterialParameterCollection;
 
 USTRUCT(BlueprintType)
 struct FORGEFX_API FRobotPartSpec
@@ -63,6 +65,25 @@ struct FORGEFX_API FRobotPartSpec
 	TSubclassOf<ARobotPartActor> DetachedActorClass;
 };
 
+/**
+ * Precomputed build order for a config, shared by every assembly built from it. Order lists spec indices with
+ * parents before children; specs whose parent is unknown (or part of a cycle) come last and attach to the root.
+ */
+struct FORGEFX_API FRobotAssemblyBuildPlan
+{
+	TArray<int32> Order;
+	TArray<int32> ParentSpecIndex; // per spec index, INDEX_NONE = actor root
+	TArray<TWeakObjectPtr<UStaticMesh>> Meshes; // per spec index, filled as meshes are resolved
+	TArray<FName> Names, ParentNames; TBitArray<> Detachable; // snapshot the plan was built from
+	TArray<FSoftObjectPath> MeshPaths; // same snapshot; a changed path must not reuse a resolved mesh
+	TArray<FName> ShowcaseOrder; // detachable parts in lexical order, Torso last
+
+	bool Matches(const TArray<FRobotPartSpec>& Parts) const;
+
+	// Cached mesh for a spec; loads synchronously only when bAllowLoad (otherwise null until resident)
+	UStaticMesh* ResolveMesh(const FRobotPartSpec& Spec, int32 SpecIndex, bool bAllowLoad);
+};
+
 UCLASS(BlueprintType)
 class FORGEFX_API URobotAssemblyConfig : public UDataAsset
 {
@@ -93,4 +114,35 @@ public:
 	// If using CustomDepthStencil mode
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Robot|Highlight", meta=(EditCondition="HighlightMode==EHighlightMode::CustomDepthStencil"))
 	int32 CustomDepthStencilValue =252; //0-255
+
+	// If using PrimitiveCustomData mode: optional collection for effects shared by every part (e.g. the reattach pulse)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Robot|Highlight", meta=(EditCondition="HighlightMode==EHighlightMode::PrimitiveCustomData"))
+	TObjectPtr<UMaterialParameterCollection> HighlightCollection = nullptr;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Robot|Highlight", meta=(EditCondition="HighlightMode==EHighlightMode::PrimitiveCustomData"))
+	FName PulseParam = TEXT("HighlightPulse");
+
+	// O(1) spec lookup by part name; returns a pointer into Parts (no copy), null if unknown
+	const FRobotPartSpec* FindPartSpec(FName PartName) const;
+	int32 FindPartIndex(FName PartName) const;
+	// Call after mutating Parts from code; load and editor edits rebuild automatically (also drops the build plan).
+	// Without it, adds/removes and renames are still picked up, except a rename to a name that already missed.
+	void RebuildPartIndex();
+
+	// Shared build plan, computed on first use and dropped whenever the part index is rebuilt
+	FRobotAssemblyBuildPlan& GetBuildPlan() const;
+	void InvalidateBuildPlan() const { BuildPlan.Reset(); }
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	void RefreshPartIndex() const; // index only, keeps the build plan
+	// Name -> index into Parts (first occurrence wins, matching the old linear search)
+	mutable TMap<FName, int32> PartIndexByName;
+	mutable int32 IndexedPartCount = INDEX_NONE;
+	mutable uint32 IndexedNameHash = 0; // name column stamp, checked before a miss re-indexes
+	mutable TSet<FName> KnownMisses; // names verified absent from the current index; cleared on every refresh
+	mutable TUniquePtr<FRobotAssemblyBuildPlan> BuildPlan;
 };
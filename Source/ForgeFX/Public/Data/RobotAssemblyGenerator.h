@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "RobotAssemblyGenerator.generated.h"
+
+class URobotAssemblyConfig;
+class UStaticMesh;
+
+UENUM(BlueprintType)
+enum class ERobotGenShape : uint8 { Cube, Sphere, Cylinder, Cone };
+
+USTRUCT(BlueprintType)
+struct FORGEFX_API FRobotAssemblyGenSettings
+{
+	GENERATED_BODY()
+
+	// Same seed + settings = same config (names, hierarchy, sockets, transforms, meshes)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) int32 Seed =1;
+	// Total parts including the Torso root; capped by the tree MaxDepth/BranchingFactor allow
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1")) int32 NumParts =10;
+	// Levels below the root
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1")) int32 MaxDepth =8;
+	// Children per part (at most SocketsPerPart when sockets are generated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1")) int32 BranchingFactor =4;
+	// Attach sockets added to each generated mesh (0 = children attach to the part origin without sockets)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", ClampMax="32")) int32 SocketsPerPart =6;
+	// Engine basic shapes to pick from (empty = cubes)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) TArray<ERobotGenShape> Shapes = { ERobotGenShape::Cube, ERobotGenShape::Sphere, ERobotGenShape::Cylinder, ERobotGenShape::Cone };
+	// Root scale; children inherit it through attachment
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0.01")) float PartScale =0.25f;
+	// Share of non-root parts that are detachable
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", ClampMax="1")) float DetachableRatio =1.f;
+};
+
+/**
+ * Procedural URobotAssemblyConfig for benchmarks and stress tests: a breadth-first part tree over engine basic
+ * shapes, no art assets needed. Socketed meshes are transient copies of the basic shapes with evenly spread
+ * sockets (one copy per shape and socket count, kept for the process); they need editor mesh building, so in
+ * cooked builds children are placed at the same socket transforms without socket names.
+ */
+UCLASS()
+class FORGEFX_API URobotAssemblyGenerator : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION(BlueprintCallable, Category="Robot|Generator")
+	static URobotAssemblyConfig* GenerateAssemblyConfig(const FRobotAssemblyGenSettings& Settings, UObject* Outer = nullptr);
+
+	// Socket layout shared by every generated mesh: outward-facing points spread over the shape's bounds
+	static FTransform GetSocketLocal(const UStaticMesh* Mesh, int32 SocketIndex, int32 NumSockets);
+	static FName GetSocketName(int32 SocketIndex);
+
+private:
+	static UStaticMesh* GetShapeMesh(ERobotGenShape Shape, int32 NumSockets);
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RobotAssemblySubsystem.generated.h"
+
+class UAssemblyBuilderComponent;
+class UCinematicAssembleComponent;
+class URobotShowcaseComponent;
+
+/**
+ * Drives highlight interpolation, cinematic lerps and showcase timers for every robot in the world from one tick.
+ * Components join an active list when they have work and drop out when idle, so idle robots cost nothing.
+ * Each frame runs a math phase (per-robot, no UObject writes; split across workers with ParallelFor when
+ * ForgeFX.Batch.Parallel is on) followed by a game-thread commit phase.
+ */
+UCLASS()
+class FORGEFX_API URobotAssemblySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	static URobotAssemblySubsystem* Get(const UWorld* World) { return World ? World->GetSubsystem<URobotAssemblySubsystem>() : nullptr; }
+
+	void AddHighlight(UAssemblyBuilderComponent* Assembly) { if (Assembly) Highlights.AddUnique(Assembly); }
+	void AddCinematic(UCinematicAssembleComponent* Cinematic) { if (Cinematic) Cinematics.AddUnique(Cinematic); }
+	void AddShowcase(URobotShowcaseComponent* Showcase) { if (Showcase) Showcases.AddUnique(Showcase); }
+
+	// Assemblies hit-tested by their own part picker instead of physics (UAssemblyBuilderComponent::bUsePartPicker)
+	void AddPicker(UAssemblyBuilderComponent* Assembly) { if (Assembly) Pickers.AddUnique(Assembly); }
+	void RemovePicker(UAssemblyBuilderComponent* Assembly) { Pickers.RemoveSingleSwap(Assembly, EAllowShrinking::No); }
+	// Nearest part on Start->End over every registered picker (skipping assemblies owned by IgnoreActor); assemblies
+	// whose combined part bounds the segment misses cost one box test
+	UAssemblyBuilderComponent* PickPart(const FVector& Start, const FVector& End, const AActor* IgnoreActor, int32& OutHandle, FVector& OutLocation, float& OutDistance) const;
+
+	int32 GetNumActive() const { return Highlights.Num() + Cinematics.Num() + Showcases.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return GetNumActive() >0; }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(URobotAssemblySubsystem, STATGROUP_Tickables); }
+
+private:
+	UPROPERTY(Transient) TArray<TObjectPtr<UAssemblyBuilderComponent>> Highlights;
+	UPROPERTY(Transient) TArray<TObjectPtr<UCinematicAssembleComponent>> Cinematics;
+	UPROPERTY(Transient) TArray<TObjectPtr<URobotShowcaseComponent>> Showcases;
+	TArray<TWeakObjectPtr<UAssemblyBuilderComponent>> Pickers; // not active work: never keeps the subsystem ticking
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RobotPartActorPool.generated.h"
+
+class ARobotPartActor;
+
+USTRUCT()
+struct FORGEFX_API FRobotPartActorPoolBucket
+{
+	GENERATED_BODY()
+	UPROPERTY(Transient) TArray<TObjectPtr<ARobotPartActor>> Idle;
+};
+
+USTRUCT(BlueprintType)
+struct FORGEFX_API FRobotPartActorPoolStats
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly, Category="Robot|Pool") int32 Hits =0; // Acquire served from the pool
+	UPROPERTY(BlueprintReadOnly, Category="Robot|Pool") int32 Misses =0; // Acquire had to spawn
+	UPROPERTY(BlueprintReadOnly, Category="Robot|Pool") int32 Released =0;
+	UPROPERTY(BlueprintReadOnly, Category="Robot|Pool") int32 Prewarmed =0;
+	UPROPERTY(BlueprintReadOnly, Category="Robot|Pool") int32 Idle =0; // currently parked across all classes
+};
+
+/**
+ * Per-world recycler for detached part actors. Released actors are parked hidden, without collision or physics and
+ * with no part name (so name-based lookups never see them); Acquire hands one back at the requested transform and
+ * the caller re-initializes it through InitializePart as if it were freshly spawned.
+ */
+UCLASS()
+class FORGEFX_API URobotPartActorPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	static URobotPartActorPool* Get(const UWorld* World) { return World ? World->GetSubsystem<URobotPartActorPool>() : nullptr; }
+
+	ARobotPartActor* Acquire(TSubclassOf<ARobotPartActor> Class, const FTransform& Transform);
+	void Release(ARobotPartActor* Actor);
+	// Ensures at least Count idle actors of Class are parked
+	UFUNCTION(BlueprintCallable, Category="Robot|Pool") void Prewarm(TSubclassOf<ARobotPartActor> Class, int32 Count);
+	UFUNCTION(BlueprintCallable, Category="Robot|Pool") void Drain();
+
+	UFUNCTION(BlueprintPure, Category="Robot|Pool") FRobotPartActorPoolStats GetStats() const { return Stats; }
+	UFUNCTION(BlueprintCallable, Category="Robot|Pool") void ResetStats() { const int32 IdleNow = Stats.Idle; Stats = FRobotPartActorPoolStats(); Stats.Idle = IdleNow; }
+	UFUNCTION(BlueprintCallable, Category="Robot|Pool") void DumpStats() const;
+
+	virtual void Deinitialize() override;
+
+private:
+	ARobotPartActor* SpawnParked(TSubclassOf<ARobotPartActor> Class, const FTransform& Transform);
+
+	UPROPERTY(Transient) TMap<TSubclassOf<ARobotPartActor>, FRobotPartActorPoolBucket> Buckets;
+	FRobotPartActorPoolStats Stats;
+};
@@ -0,0 +1,19 @@
+#pragma once
+// Headless soak run: many robots, random detach / reattach / scramble / cinematic / showcase for hours, with
+// memory, actor and frame time samples so leaks show up as trends.
+// UnrealEditor-Cmd <Project>.uproject -run=ForgeFXSoak -nullrhi -unattended [-Minutes=60] [-Robots=32] [-Parts=24]
+//   [-Seed=1] [-ActionsPerSecond=5] [-SampleSeconds=10] [-WarmupPercent=20] [-LeakTolerance=0.1]
+//   [-RobotClass=/Game/Path/BP_Robot.BP_Robot_C] [-Out=<dir>] [-FailOnLeak]
+
+#include "Commandlets/Commandlet.h"
+#include "ForgeFXSoakCommandlet.generated.h"
+
+UCLASS()
+class FORGEFX_API UForgeFXSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UForgeFXSoakCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};